@@ -0,0 +1,499 @@
+#include "pch.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FOX_BLOCK_COMPRESSION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Fox {
+
+	namespace Core {
+
+        static void BlockMinMax(const uint8_t* block, uint8_t* minColor, uint8_t* maxColor) {
+#ifdef FOX_BLOCK_COMPRESSION_SSE2
+            __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+            __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32));
+            __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48));
+
+            __m128i minimum = _mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3));
+            __m128i maximum = _mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3));
+
+            // fold the four pixels of a row into one
+            minimum = _mm_min_epu8(minimum, _mm_shuffle_epi32(minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+            minimum = _mm_min_epu8(minimum, _mm_shuffle_epi32(minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+            maximum = _mm_max_epu8(maximum, _mm_shuffle_epi32(maximum, _MM_SHUFFLE(2, 3, 0, 1)));
+            maximum = _mm_max_epu8(maximum, _mm_shuffle_epi32(maximum, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            int32_t minValue = _mm_cvtsi128_si32(minimum);
+            int32_t maxValue = _mm_cvtsi128_si32(maximum);
+            memcpy(minColor, &minValue, 4);
+            memcpy(maxColor, &maxValue, 4);
+#else
+            for (uint32_t c = 0u; c < 4u; c++) {
+                minColor[c] = 255u;
+                maxColor[c] = 0u;
+            }
+
+            for (uint32_t i = 0u; i < 16u; i++) {
+                for (uint32_t c = 0u; c < 4u; c++) {
+                    minColor[c] = std::min(minColor[c], block[i * 4u + c]);
+                    maxColor[c] = std::max(maxColor[c], block[i * 4u + c]);
+                }
+            }
+#endif
+        }
+
+        // shrinks the bounding box by 1/16 of its range, endpoints on the box corners are usually outliers
+        static void InsetBoundingBox(uint8_t* minColor, uint8_t* maxColor, uint32_t channels) {
+            for (uint32_t c = 0u; c < channels; c++) {
+                int32_t inset = (maxColor[c] - minColor[c]) >> 4;
+                minColor[c] = static_cast<uint8_t>(std::min(255, minColor[c] + inset));
+                maxColor[c] = static_cast<uint8_t>(std::max(0, maxColor[c] - inset));
+            }
+        }
+
+        // the bounding box diagonal from min to max assumes all channels are positively correlated,
+        // flip the channels that correlate negatively with the widest one
+        static void SelectDiagonal(const uint8_t* block, uint8_t* minColor, uint8_t* maxColor, uint32_t channels) {
+            uint32_t reference = 0u;
+            for (uint32_t c = 1u; c < channels; c++) {
+                if (maxColor[c] - minColor[c] > maxColor[reference] - minColor[reference]) {
+                    reference = c;
+                }
+            }
+
+            int32_t center[4];
+            for (uint32_t c = 0u; c < channels; c++) {
+                center[c] = (minColor[c] + maxColor[c] + 1) >> 1;
+            }
+
+            int32_t covariance[4] = { 0, 0, 0, 0 };
+            for (uint32_t i = 0u; i < 16u; i++) {
+                int32_t referenceOffset = block[i * 4u + reference] - center[reference];
+                for (uint32_t c = 0u; c < channels; c++) {
+                    covariance[c] += referenceOffset * (block[i * 4u + c] - center[c]);
+                }
+            }
+
+            for (uint32_t c = 0u; c < channels; c++) {
+                if (covariance[c] < 0) {
+                    std::swap(minColor[c], maxColor[c]);
+                }
+            }
+        }
+
+        // index of the nearest palette entry for every pixel of the block, ties go to the lower index. With three channels
+        // alpha takes no part in the distance.
+        static void FindNearest(const uint8_t* block, const int32_t (*palette)[4], uint32_t paletteSize, uint32_t channels, uint32_t* indices) {
+#ifdef FOX_BLOCK_COMPRESSION_SSE2
+            __m128i zero = _mm_setzero_si128();
+            __m128i channelMask = _mm_set1_epi32(channels == 4u ? -1 : 0x00FFFFFF);
+
+            // every entry twice, to match two pixels widened to 16 bits
+            __m128i entries[16];
+            for (uint32_t p = 0u; p < paletteSize; p++) {
+                int16_t r = static_cast<int16_t>(palette[p][0]);
+                int16_t g = static_cast<int16_t>(palette[p][1]);
+                int16_t b = static_cast<int16_t>(palette[p][2]);
+                int16_t a = channels == 4u ? static_cast<int16_t>(palette[p][3]) : 0;
+                entries[p] = _mm_setr_epi16(r, g, b, a, r, g, b, a);
+            }
+
+            // one row of four pixels at a time
+            for (uint32_t row = 0u; row < 4u; row++) {
+                __m128i pixels = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + row * 16u)), channelMask);
+                __m128i low = _mm_unpacklo_epi8(pixels, zero);
+                __m128i high = _mm_unpackhi_epi8(pixels, zero);
+
+                __m128i bestError = _mm_set1_epi32(INT32_MAX);
+                __m128i bestIndex = zero;
+
+                for (uint32_t p = 0u; p < paletteSize; p++) {
+                    __m128i lowDifference = _mm_sub_epi16(low, entries[p]);
+                    __m128i highDifference = _mm_sub_epi16(high, entries[p]);
+
+                    // madd leaves two partial sums per pixel, rg and ba, which are paired up and added
+                    __m128 lowSums = _mm_castsi128_ps(_mm_madd_epi16(lowDifference, lowDifference));
+                    __m128 highSums = _mm_castsi128_ps(_mm_madd_epi16(highDifference, highDifference));
+                    __m128i error = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(lowSums, highSums, _MM_SHUFFLE(2, 0, 2, 0))),
+                        _mm_castps_si128(_mm_shuffle_ps(lowSums, highSums, _MM_SHUFFLE(3, 1, 3, 1))));
+
+                    __m128i better = _mm_cmplt_epi32(error, bestError);
+                    bestError = _mm_or_si128(_mm_and_si128(better, error), _mm_andnot_si128(better, bestError));
+                    bestIndex = _mm_or_si128(_mm_and_si128(better, _mm_set1_epi32(static_cast<int32_t>(p))), _mm_andnot_si128(better, bestIndex));
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + row * 4u), bestIndex);
+            }
+#else
+            for (uint32_t i = 0u; i < 16u; i++) {
+                const uint8_t* pixel = block + i * 4u;
+                int32_t bestError = INT32_MAX;
+                indices[i] = 0u;
+
+                for (uint32_t p = 0u; p < paletteSize; p++) {
+                    int32_t error = 0;
+                    for (uint32_t c = 0u; c < channels; c++) {
+                        int32_t difference = pixel[c] - palette[p][c];
+                        error += difference * difference;
+                    }
+                    if (error < bestError) {
+                        bestError = error;
+                        indices[i] = p;
+                    }
+                }
+            }
+#endif
+        }
+
+        // the same for a single channel against the eight values of a BC4 block
+        static void FindNearestValue(const uint8_t* block, uint32_t channel, const int32_t* palette, uint32_t* indices) {
+#ifdef FOX_BLOCK_COMPRESSION_SSE2
+            __m128i byteMask = _mm_set1_epi32(0xFF);
+            __m128i shift = _mm_cvtsi32_si128(static_cast<int32_t>(channel * 8u));
+
+            // the channel of all 16 pixels as 16-bit values, two rows per register
+            __m128i values[2];
+            for (uint32_t half = 0u; half < 2u; half++) {
+                __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + half * 32u));
+                __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + half * 32u + 16u));
+                values[half] = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(row0, shift), byteMask), _mm_and_si128(_mm_srl_epi32(row1, shift), byteMask));
+            }
+
+            for (uint32_t half = 0u; half < 2u; half++) {
+                __m128i bestError = _mm_set1_epi16(INT16_MAX);
+                __m128i bestIndex = _mm_setzero_si128();
+
+                for (uint32_t p = 0u; p < 8u; p++) {
+                    __m128i difference = _mm_sub_epi16(values[half], _mm_set1_epi16(static_cast<int16_t>(palette[p])));
+                    __m128i error = _mm_max_epi16(difference, _mm_sub_epi16(_mm_setzero_si128(), difference));
+
+                    __m128i better = _mm_cmplt_epi16(error, bestError);
+                    bestError = _mm_min_epi16(error, bestError);
+                    bestIndex = _mm_or_si128(_mm_and_si128(better, _mm_set1_epi16(static_cast<int16_t>(p))), _mm_andnot_si128(better, bestIndex));
+                }
+
+                alignas(16) uint16_t halfIndices[8];
+                _mm_store_si128(reinterpret_cast<__m128i*>(halfIndices), bestIndex);
+                for (uint32_t i = 0u; i < 8u; i++) {
+                    indices[half * 8u + i] = halfIndices[i];
+                }
+            }
+#else
+            for (uint32_t i = 0u; i < 16u; i++) {
+                int32_t value = block[i * 4u + channel];
+                int32_t bestError = INT32_MAX;
+                indices[i] = 0u;
+
+                for (uint32_t p = 0u; p < 8u; p++) {
+                    int32_t error = std::abs(value - palette[p]);
+                    if (error < bestError) {
+                        bestError = error;
+                        indices[i] = p;
+                    }
+                }
+            }
+#endif
+        }
+
+        static uint16_t ToRGB565(const uint8_t* color) {
+            return static_cast<uint16_t>(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | ((color[2] * 31 + 127) / 255));
+        }
+
+        static void FromRGB565(uint16_t value, int32_t* color) {
+            int32_t r = (value >> 11) & 31;
+            int32_t g = (value >> 5) & 63;
+            int32_t b = value & 31;
+            color[0] = (r << 3) | (r >> 2);
+            color[1] = (g << 2) | (g >> 4);
+            color[2] = (b << 3) | (b >> 2);
+        }
+
+        uint32_t BlockCompression::GetBlockSize(BlockFormat format) {
+            return format == BlockFormat::BC1 ? 8u : 16u;
+        }
+
+        size_t BlockCompression::GetCompressedSize(BlockFormat format, uint32_t width, uint32_t height) {
+            size_t blocksX = (width + 3u) / 4u;
+            size_t blocksY = (height + 3u) / 4u;
+            return blocksX * blocksY * GetBlockSize(format);
+        }
+
+        void BlockCompression::LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* block) {
+            // partial blocks at the right and bottom edge repeat the last row/column
+            for (uint32_t y = 0u; y < 4u; y++) {
+                uint32_t sourceY = std::min(blockY * 4u + y, height - 1u);
+                for (uint32_t x = 0u; x < 4u; x++) {
+                    uint32_t sourceX = std::min(blockX * 4u + x, width - 1u);
+                    memcpy(block + (y * 4u + x) * 4u, rgba + (static_cast<size_t>(sourceY) * width + sourceX) * 4u, 4u);
+                }
+            }
+        }
+
+        void BlockCompression::EncodeBC1(const uint8_t* block, uint8_t* output) {
+            uint8_t minColor[4], maxColor[4];
+            BlockMinMax(block, minColor, maxColor);
+            InsetBoundingBox(minColor, maxColor, 3u);
+            SelectDiagonal(block, minColor, maxColor, 3u);
+
+            uint16_t color0 = ToRGB565(maxColor);
+            uint16_t color1 = ToRGB565(minColor);
+
+            uint32_t indices = 0u;
+
+            if (color0 != color1) {
+                // color0 > color1 selects the four color mode
+                if (color0 < color1) {
+                    std::swap(color0, color1);
+                }
+
+                int32_t palette[4][4];
+                FromRGB565(color0, palette[0]);
+                FromRGB565(color1, palette[1]);
+                for (uint32_t c = 0u; c < 3u; c++) {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+
+                uint32_t nearest[16];
+                FindNearest(block, palette, 4u, 3u, nearest);
+                for (uint32_t i = 0u; i < 16u; i++) {
+                    indices |= nearest[i] << (i * 2u);
+                }
+            }
+
+            output[0] = static_cast<uint8_t>(color0 & 0xFF);
+            output[1] = static_cast<uint8_t>(color0 >> 8);
+            output[2] = static_cast<uint8_t>(color1 & 0xFF);
+            output[3] = static_cast<uint8_t>(color1 >> 8);
+            memcpy(output + 4, &indices, 4);
+        }
+
+        void BlockCompression::EncodeBC4(const uint8_t* block, uint32_t channel, uint8_t* output) {
+            uint8_t minValue = 255u;
+            uint8_t maxValue = 0u;
+            for (uint32_t i = 0u; i < 16u; i++) {
+                minValue = std::min(minValue, block[i * 4u + channel]);
+                maxValue = std::max(maxValue, block[i * 4u + channel]);
+            }
+
+            output[0] = maxValue;
+            output[1] = minValue;
+
+            uint64_t indices = 0u;
+
+            // with endpoint0 > endpoint1 the block interpolates six values in between
+            if (maxValue != minValue) {
+                int32_t palette[8];
+                palette[0] = maxValue;
+                palette[1] = minValue;
+                for (int32_t p = 2; p < 8; p++) {
+                    palette[p] = ((8 - p) * maxValue + (p - 1) * minValue) / 7;
+                }
+
+                uint32_t nearest[16];
+                FindNearestValue(block, channel, palette, nearest);
+                for (uint32_t i = 0u; i < 16u; i++) {
+                    indices |= static_cast<uint64_t>(nearest[i]) << (i * 3u);
+                }
+            }
+
+            for (uint32_t b = 0u; b < 6u; b++) {
+                output[2 + b] = static_cast<uint8_t>(indices >> (b * 8u));
+            }
+        }
+
+        void BlockCompression::EncodeBC3(const uint8_t* block, uint8_t* output) {
+            EncodeBC4(block, 3u, output);
+            EncodeBC1(block, output + 8);
+        }
+
+        void BlockCompression::EncodeBC5(const uint8_t* block, uint8_t* output) {
+            EncodeBC4(block, 0u, output);
+            EncodeBC4(block, 1u, output + 8);
+        }
+
+        class BitWriter {
+        public:
+            BitWriter(uint8_t* output) : output(output) {
+                memset(output, 0, 16);
+            }
+
+            void Write(uint32_t value, uint32_t bits) {
+                for (uint32_t b = 0u; b < bits; b++, position++) {
+                    if (value & (1u << b)) {
+                        output[position >> 3u] |= static_cast<uint8_t>(1u << (position & 7u));
+                    }
+                }
+            }
+
+        private:
+            uint8_t* output;
+            uint32_t position = 0u;
+        };
+
+        // Mode 6: one subset, RGBA endpoints with 7 bits per channel plus a p-bit per endpoint and 4-bit indices.
+        // It is the cheapest mode to search and already beats BC3 on smooth content.
+        void BlockCompression::EncodeBC7(const uint8_t* block, uint8_t* output) {
+            static const int32_t weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+            uint8_t minColor[4], maxColor[4];
+            BlockMinMax(block, minColor, maxColor);
+            InsetBoundingBox(minColor, maxColor, 4u);
+            SelectDiagonal(block, minColor, maxColor, 4u);
+
+            const uint8_t* endpoints[2] = { minColor, maxColor };
+            uint32_t quantized[2][4];
+            uint32_t pBits[2];
+            int32_t expanded[2][4];
+
+            for (uint32_t e = 0u; e < 2u; e++) {
+                int32_t bestError = INT32_MAX;
+
+                for (uint32_t p = 0u; p < 2u; p++) {
+                    int32_t error = 0;
+                    uint32_t candidate[4];
+
+                    for (uint32_t c = 0u; c < 4u; c++) {
+                        int32_t value = (static_cast<int32_t>(endpoints[e][c]) - static_cast<int32_t>(p) + 1) >> 1;
+                        candidate[c] = static_cast<uint32_t>(std::clamp(value, 0, 127));
+                        error += std::abs(static_cast<int32_t>((candidate[c] << 1) | p) - endpoints[e][c]);
+                    }
+
+                    if (error < bestError) {
+                        bestError = error;
+                        pBits[e] = p;
+                        for (uint32_t c = 0u; c < 4u; c++) {
+                            quantized[e][c] = candidate[c];
+                        }
+                    }
+                }
+
+                for (uint32_t c = 0u; c < 4u; c++) {
+                    expanded[e][c] = static_cast<int32_t>((quantized[e][c] << 1) | pBits[e]);
+                }
+            }
+
+            int32_t palette[16][4];
+            for (uint32_t i = 0u; i < 16u; i++) {
+                for (uint32_t c = 0u; c < 4u; c++) {
+                    palette[i][c] = ((64 - weights[i]) * expanded[0][c] + weights[i] * expanded[1][c] + 32) >> 6;
+                }
+            }
+
+            uint32_t indices[16];
+            FindNearest(block, palette, 16u, 4u, indices);
+
+            // the anchor index is stored with its top bit implied zero
+            if (indices[0] & 8u) {
+                std::swap(quantized[0], quantized[1]);
+                std::swap(pBits[0], pBits[1]);
+                for (uint32_t i = 0u; i < 16u; i++) {
+                    indices[i] = 15u - indices[i];
+                }
+            }
+
+            BitWriter writer(output);
+            writer.Write(1u << 6u, 7u);
+
+            for (uint32_t c = 0u; c < 4u; c++) {
+                writer.Write(quantized[0][c], 7u);
+                writer.Write(quantized[1][c], 7u);
+            }
+
+            writer.Write(pBits[0], 1u);
+            writer.Write(pBits[1], 1u);
+
+            writer.Write(indices[0], 3u);
+            for (uint32_t i = 1u; i < 16u; i++) {
+                writer.Write(indices[i], 4u);
+            }
+        }
+
+        std::vector<uint8_t> BlockCompression::Compress(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, Fox::Core::ThreadPool* threadPool) {
+            std::vector<uint8_t> output(GetCompressedSize(format, width, height));
+            CompressTo(format, rgba, width, height, output.data(), threadPool);
+            return output;
+        }
+
+        void BlockCompression::CompressTo(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* output, Fox::Core::ThreadPool* threadPool) {
+            if (width == 0u || height == 0u) {
+                return;
+            }
+
+            uint32_t blocksX = (width + 3u) / 4u;
+            uint32_t blocksY = (height + 3u) / 4u;
+            uint32_t blockSize = GetBlockSize(format);
+
+            auto encodeRow = [=](uint32_t blockY) {
+                alignas(16) uint8_t block[64];
+                uint8_t* rowOutput = output + static_cast<size_t>(blockY) * blocksX * blockSize;
+
+                for (uint32_t blockX = 0u; blockX < blocksX; blockX++) {
+                    LoadBlock(rgba, width, height, blockX, blockY, block);
+                    uint8_t* blockOutput = rowOutput + static_cast<size_t>(blockX) * blockSize;
+
+                    switch (format) {
+                    case BlockFormat::BC1:
+                        EncodeBC1(block, blockOutput);
+                        break;
+                    case BlockFormat::BC3:
+                        EncodeBC3(block, blockOutput);
+                        break;
+                    case BlockFormat::BC5:
+                        EncodeBC5(block, blockOutput);
+                        break;
+                    case BlockFormat::BC7:
+                        EncodeBC7(block, blockOutput);
+                        break;
+                    }
+                }
+            };
+
+            if (threadPool) {
+                threadPool->ParallelFor(blocksY, encodeRow);
+            } else {
+                for (uint32_t blockY = 0u; blockY < blocksY; blockY++) {
+                    encodeRow(blockY);
+                }
+            }
+        }
+
+        void BlockCompression::Benchmark(uint32_t width, uint32_t height, Fox::Core::ThreadPool* threadPool) {
+            std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4u);
+            std::mt19937 random(1234u);
+
+            // smooth gradients with some noise, closer to real textures than pure noise
+            for (uint32_t y = 0u; y < height; y++) {
+                for (uint32_t x = 0u; x < width; x++) {
+                    uint8_t* pixel = &image[(static_cast<size_t>(y) * width + x) * 4u];
+                    uint32_t noise = random() & 15u;
+                    pixel[0] = static_cast<uint8_t>((x * 255u / width + noise) & 0xFF);
+                    pixel[1] = static_cast<uint8_t>((y * 255u / height + noise) & 0xFF);
+                    pixel[2] = static_cast<uint8_t>(((x + y) * 127u / (width + height) + noise) & 0xFF);
+                    pixel[3] = static_cast<uint8_t>(255u - (noise << 2));
+                }
+            }
+
+            const std::pair<BlockFormat, const char*> formats[] = {
+                { BlockFormat::BC1, "BC1" }, { BlockFormat::BC3, "BC3" }, { BlockFormat::BC5, "BC5" }, { BlockFormat::BC7, "BC7" }
+            };
+
+            std::vector<uint8_t> output;
+            for (const auto& format : formats) {
+                output.resize(GetCompressedSize(format.first, width, height));
+
+                auto start = std::chrono::high_resolution_clock::now();
+                CompressTo(format.first, image.data(), width, height, output.data(), threadPool);
+                auto end = std::chrono::high_resolution_clock::now();
+
+                double seconds = std::chrono::duration<double>(end - start).count();
+                double megapixels = static_cast<double>(width) * height / 1.0e6;
+
+                std::cout << format.second << ": " << width << "x" << height << " in " << seconds * 1000.0 << " ms, "
+                    << megapixels / seconds << " Mpixels/s (" << (threadPool ? threadPool->GetThreadCount() + 1u : 1u) << " threads)" << std::endl;
+            }
+        }
+	}
+}
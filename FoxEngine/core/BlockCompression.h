@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Fox {
+
+	namespace Core {
+
+		class ThreadPool;
+
+		enum class BlockFormat {
+			BC1 = 0,	// RGB, 1-bit alpha ignored, 8 bytes per block
+			BC3,		// RGBA, 16 bytes per block
+			BC5,		// two channel (RG), 16 bytes per block
+			BC7			// RGBA, mode 6 only, 16 bytes per block
+		};
+
+		// CPU encoder for 4x4 block compressed formats. Input is tightly packed RGBA8, the output blocks are laid out row by row
+		// exactly as Vulkan expects them for a VK_FORMAT_BC*_BLOCK image. Nothing here depends on the GPU.
+		class BlockCompression {
+		public:
+
+			static uint32_t GetBlockSize(BlockFormat format);
+			static size_t GetCompressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+			// block rows are encoded in parallel when a thread pool is given
+			static std::vector<uint8_t> Compress(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, Fox::Core::ThreadPool* threadPool = nullptr);
+			static void CompressTo(BlockFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* output, Fox::Core::ThreadPool* threadPool = nullptr);
+
+			// encodes a synthetic image and prints the throughput of every format
+			static void Benchmark(uint32_t width, uint32_t height, Fox::Core::ThreadPool* threadPool = nullptr);
+
+		private:
+
+			static void LoadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* block);
+
+			static void EncodeBC1(const uint8_t* block, uint8_t* output);
+			static void EncodeBC3(const uint8_t* block, uint8_t* output);
+			static void EncodeBC4(const uint8_t* block, uint32_t channel, uint8_t* output);
+			static void EncodeBC5(const uint8_t* block, uint8_t* output);
+			static void EncodeBC7(const uint8_t* block, uint8_t* output);
+		};
+	}
+}
@@ -26,6 +26,11 @@ namespace Fox {
 
 				Fox::Core::Json::JSONValue& operator[](std::string& key);
 
+				// Get inserts missing keys, check optional attributes with this first
+				bool Has(const std::string& key) const {
+					return attributes.find(key) != attributes.end();
+				}
+
 				Fox::Core::Json::JSONObject& Get() {
 					return *this;
 				}
@@ -0,0 +1,103 @@
+#include "pch.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Fox {
+
+	namespace Core {
+
+        MappedFile::~MappedFile() {
+            Close();
+        }
+
+        bool MappedFile::Open(const std::string& path) {
+            Close();
+
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+                CloseHandle(file);
+                return false;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) {
+                CloseHandle(file);
+                return false;
+            }
+
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!view) {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                return false;
+            }
+
+            fileHandle = file;
+            mappingHandle = mapping;
+            data = static_cast<const uint8_t*>(view);
+            size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+            int descriptor = open(path.c_str(), O_RDONLY);
+            if (descriptor < 0) {
+                return false;
+            }
+
+            struct stat status;
+            if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+                close(descriptor);
+                return false;
+            }
+
+            void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (view == MAP_FAILED) {
+                close(descriptor);
+                return false;
+            }
+
+            fileDescriptor = descriptor;
+            data = static_cast<const uint8_t*>(view);
+            size = static_cast<uint64_t>(status.st_size);
+#endif
+            return true;
+        }
+
+        void MappedFile::Close() {
+            if (!data) {
+                return;
+            }
+
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            mappingHandle = nullptr;
+            fileHandle = nullptr;
+#else
+            munmap(const_cast<uint8_t*>(data), static_cast<size_t>(size));
+            close(fileDescriptor);
+            fileDescriptor = -1;
+#endif
+            data = nullptr;
+            size = 0u;
+        }
+	}
+}
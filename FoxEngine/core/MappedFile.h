@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Fox {
+
+	namespace Core {
+
+		// Read-only memory mapping of a whole file, the pages are only touched when the data is read.
+		class MappedFile {
+		public:
+			MappedFile() = default;
+			~MappedFile();
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			bool Open(const std::string& path);
+			void Close();
+
+			inline const uint8_t* GetData() const {
+				return data;
+			}
+
+			inline uint64_t GetSize() const {
+				return size;
+			}
+
+			inline bool IsOpen() const {
+				return data != nullptr;
+			}
+
+		private:
+#ifdef _WIN32
+			void* fileHandle = nullptr;
+			void* mappingHandle = nullptr;
+#else
+			int fileDescriptor = -1;
+#endif
+			const uint8_t* data = nullptr;
+			uint64_t size = 0u;
+		};
+	}
+}
@@ -0,0 +1,270 @@
+#include "pch.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FOX_MIP_GENERATOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Fox {
+
+	namespace Core {
+
+        static const float PI = 3.14159265358979f;
+        static const uint32_t LINEAR_TO_SRGB_SIZE = 4096u;
+
+        static float SrgbToLinear(float value) {
+            return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        static float LinearToSrgb(float value) {
+            return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        }
+
+        // decoding is exact through a byte table, encoding goes through a table fine enough to round to the right byte
+        static const std::array<float, 256>& GetSrgbToLinearTable() {
+            static const std::array<float, 256> table = []() {
+                std::array<float, 256> values{};
+                for (uint32_t i = 0u; i < 256u; i++) {
+                    values[i] = SrgbToLinear(static_cast<float>(i) / 255.0f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        static const std::array<uint8_t, LINEAR_TO_SRGB_SIZE>& GetLinearToSrgbTable() {
+            static const std::array<uint8_t, LINEAR_TO_SRGB_SIZE> table = []() {
+                std::array<uint8_t, LINEAR_TO_SRGB_SIZE> values{};
+                for (uint32_t i = 0u; i < LINEAR_TO_SRGB_SIZE; i++) {
+                    float linear = (static_cast<float>(i) + 0.5f) / static_cast<float>(LINEAR_TO_SRGB_SIZE);
+                    values[i] = static_cast<uint8_t>(std::lround(LinearToSrgb(linear) * 255.0f));
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        static float Sinc(float x) {
+            if (std::abs(x) < 1.0e-5f) {
+                return 1.0f;
+            }
+            return std::sin(PI * x) / (PI * x);
+        }
+
+        static float BesselI0(float x) {
+            float sum = 1.0f;
+            float term = 1.0f;
+            float quarter = x * x * 0.25f;
+
+            for (uint32_t k = 1u; k < 32u; k++) {
+                term *= quarter / static_cast<float>(k * k);
+                sum += term;
+                if (term < sum * 1.0e-8f) {
+                    break;
+                }
+            }
+            return sum;
+        }
+
+        uint32_t MipGenerator::GetLevelCount(uint32_t width, uint32_t height) {
+            uint32_t size = std::max(width, height);
+            uint32_t levels = 1u;
+            while (size > 1u) {
+                size >>= 1u;
+                levels++;
+            }
+            return levels;
+        }
+
+        float MipGenerator::GetRadius(Fox::Core::MipFilter filter) {
+            switch (filter) {
+            case MipFilter::Box:
+                return 0.5f;
+            default:
+                return 3.0f;
+            }
+        }
+
+        float MipGenerator::Evaluate(Fox::Core::MipFilter filter, float x) {
+            float radius = GetRadius(filter);
+            x = std::abs(x);
+
+            switch (filter) {
+            case MipFilter::Box:
+                return x <= radius ? 1.0f : 0.0f;
+            case MipFilter::Kaiser: {
+                if (x >= radius) {
+                    return 0.0f;
+                }
+                const float alpha = 4.0f;
+                float t = x / radius;
+                return Sinc(x) * BesselI0(alpha * std::sqrt(1.0f - t * t)) / BesselI0(alpha);
+            }
+            case MipFilter::Lanczos:
+                return x < radius ? Sinc(x) * Sinc(x / radius) : 0.0f;
+            }
+            return 0.0f;
+        }
+
+        std::vector<MipGenerator::Contribution> MipGenerator::ComputeContributions(Fox::Core::MipFilter filter, uint32_t sourceSize, uint32_t targetSize) {
+            std::vector<Contribution> contributions(targetSize);
+
+            // the kernel is stretched by the reduction factor so it stays a low pass filter in target space
+            float scale = static_cast<float>(sourceSize) / static_cast<float>(targetSize);
+            float support = GetRadius(filter) * scale;
+
+            for (uint32_t i = 0u; i < targetSize; i++) {
+                float center = (static_cast<float>(i) + 0.5f) * scale;
+                int32_t first = static_cast<int32_t>(std::floor(center - support));
+                int32_t last = static_cast<int32_t>(std::ceil(center + support));
+
+                int32_t minIndex = std::clamp(first, 0, static_cast<int32_t>(sourceSize) - 1);
+                int32_t maxIndex = std::clamp(last, 0, static_cast<int32_t>(sourceSize) - 1);
+
+                Contribution& contribution = contributions[i];
+                contribution.first = static_cast<uint32_t>(minIndex);
+                contribution.weights.assign(static_cast<size_t>(maxIndex - minIndex + 1), 0.0f);
+
+                // taps outside the image are folded onto the edge texel
+                float sum = 0.0f;
+                for (int32_t j = first; j <= last; j++) {
+                    float weight = Evaluate(filter, (static_cast<float>(j) + 0.5f - center) / scale);
+                    int32_t index = std::clamp(j, 0, static_cast<int32_t>(sourceSize) - 1);
+                    contribution.weights[index - minIndex] += weight;
+                    sum += weight;
+                }
+
+                for (float& weight : contribution.weights) {
+                    weight /= sum;
+                }
+            }
+
+            return contributions;
+        }
+
+        void MipGenerator::Downsample(const std::vector<float>& source, uint32_t width, uint32_t height, std::vector<float>& target,
+            uint32_t targetWidth, uint32_t targetHeight, Fox::Core::MipFilter filter, Fox::Core::ThreadPool* threadPool) {
+
+            std::vector<Contribution> horizontal = ComputeContributions(filter, width, targetWidth);
+            std::vector<Contribution> vertical = ComputeContributions(filter, height, targetHeight);
+
+            // horizontal pass keeps the source height, the vertical pass then reads whole rows of it
+            std::vector<float> intermediate(static_cast<size_t>(targetWidth) * height * 4u);
+            target.resize(static_cast<size_t>(targetWidth) * targetHeight * 4u);
+
+            auto filterRow = [&](uint32_t y) {
+                const float* sourceRow = &source[static_cast<size_t>(y) * width * 4u];
+                float* targetRow = &intermediate[static_cast<size_t>(y) * targetWidth * 4u];
+
+                for (uint32_t x = 0u; x < targetWidth; x++) {
+                    const Contribution& contribution = horizontal[x];
+                    const float* texel = sourceRow + static_cast<size_t>(contribution.first) * 4u;
+#ifdef FOX_MIP_GENERATOR_SSE2
+                    __m128 sum = _mm_setzero_ps();
+                    for (size_t i = 0u; i < contribution.weights.size(); i++) {
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(texel + i * 4u), _mm_set1_ps(contribution.weights[i])));
+                    }
+                    _mm_storeu_ps(targetRow + static_cast<size_t>(x) * 4u, sum);
+#else
+                    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    for (size_t i = 0u; i < contribution.weights.size(); i++) {
+                        for (uint32_t c = 0u; c < 4u; c++) {
+                            sum[c] += texel[i * 4u + c] * contribution.weights[i];
+                        }
+                    }
+                    memcpy(targetRow + static_cast<size_t>(x) * 4u, sum, sizeof(sum));
+#endif
+                }
+            };
+
+            auto filterColumn = [&](uint32_t y) {
+                const Contribution& contribution = vertical[y];
+                float* targetRow = &target[static_cast<size_t>(y) * targetWidth * 4u];
+                size_t rowStride = static_cast<size_t>(targetWidth) * 4u;
+
+                for (uint32_t x = 0u; x < targetWidth; x++) {
+                    const float* texel = &intermediate[static_cast<size_t>(contribution.first) * rowStride + static_cast<size_t>(x) * 4u];
+#ifdef FOX_MIP_GENERATOR_SSE2
+                    __m128 sum = _mm_setzero_ps();
+                    for (size_t i = 0u; i < contribution.weights.size(); i++) {
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(texel + i * rowStride), _mm_set1_ps(contribution.weights[i])));
+                    }
+                    _mm_storeu_ps(targetRow + static_cast<size_t>(x) * 4u, sum);
+#else
+                    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    for (size_t i = 0u; i < contribution.weights.size(); i++) {
+                        for (uint32_t c = 0u; c < 4u; c++) {
+                            sum[c] += texel[i * rowStride + c] * contribution.weights[i];
+                        }
+                    }
+                    memcpy(targetRow + static_cast<size_t>(x) * 4u, sum, sizeof(sum));
+#endif
+                }
+            };
+
+            if (threadPool) {
+                threadPool->ParallelFor(height, filterRow);
+                threadPool->ParallelFor(targetHeight, filterColumn);
+            } else {
+                for (uint32_t y = 0u; y < height; y++) {
+                    filterRow(y);
+                }
+                for (uint32_t y = 0u; y < targetHeight; y++) {
+                    filterColumn(y);
+                }
+            }
+        }
+
+        void MipGenerator::Quantize(const std::vector<float>& source, uint32_t width, uint32_t height, bool srgb, uint8_t* target) {
+            const std::array<uint8_t, LINEAR_TO_SRGB_SIZE>& encode = GetLinearToSrgbTable();
+            size_t count = static_cast<size_t>(width) * height * 4u;
+
+            for (size_t i = 0u; i < count; i++) {
+                // sinc based filters ring, results are clamped back into range
+                float value = std::clamp(source[i], 0.0f, 1.0f);
+
+                if (srgb && (i & 3u) != 3u) {
+                    target[i] = encode[std::min(static_cast<uint32_t>(value * LINEAR_TO_SRGB_SIZE), LINEAR_TO_SRGB_SIZE - 1u)];
+                } else {
+                    target[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+                }
+            }
+        }
+
+        std::vector<Fox::Core::MipImage> MipGenerator::Generate(const uint8_t* rgba, uint32_t width, uint32_t height, Fox::Core::MipFilter filter,
+            bool srgb, Fox::Core::ThreadPool* threadPool) {
+
+            std::vector<Fox::Core::MipImage> chain(GetLevelCount(width, height));
+
+            chain[0].width = width;
+            chain[0].height = height;
+            chain[0].pixels.assign(rgba, rgba + static_cast<size_t>(width) * height * 4u);
+
+            const std::array<float, 256>& decode = GetSrgbToLinearTable();
+            std::vector<float> current(static_cast<size_t>(width) * height * 4u);
+
+            for (size_t i = 0u; i < current.size(); i++) {
+                current[i] = srgb && (i & 3u) != 3u ? decode[rgba[i]] : static_cast<float>(rgba[i]) / 255.0f;
+            }
+
+            std::vector<float> next;
+            for (size_t level = 1u; level < chain.size(); level++) {
+                uint32_t targetWidth = std::max(width >> 1u, 1u);
+                uint32_t targetHeight = std::max(height >> 1u, 1u);
+
+                Downsample(current, width, height, next, targetWidth, targetHeight, filter, threadPool);
+
+                chain[level].width = targetWidth;
+                chain[level].height = targetHeight;
+                chain[level].pixels.resize(static_cast<size_t>(targetWidth) * targetHeight * 4u);
+                Quantize(next, targetWidth, targetHeight, srgb, chain[level].pixels.data());
+
+                std::swap(current, next);
+                width = targetWidth;
+                height = targetHeight;
+            }
+
+            return chain;
+        }
+	}
+}
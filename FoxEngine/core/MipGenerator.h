@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Fox {
+
+	namespace Core {
+
+		class ThreadPool;
+
+		enum class MipFilter {
+			Box = 0,	// 2x2 average, cheapest and softest
+			Kaiser,		// Kaiser windowed sinc, radius 3
+			Lanczos		// Lanczos 3
+		};
+
+		struct MipImage {
+			uint32_t width = 0u;
+			uint32_t height = 0u;
+			std::vector<uint8_t> pixels;	// tightly packed RGBA8
+		};
+
+		// CPU mip chain generator for RGBA8 images. Filtering happens in linear float space, colour channels of sRGB images are
+		// decoded before and encoded after filtering while alpha is always linear. Each level is filtered from the unquantized previous level.
+		class MipGenerator {
+		public:
+
+			static uint32_t GetLevelCount(uint32_t width, uint32_t height);
+
+			// returns the full chain, level 0 included, rows of every pass are spread over the thread pool when given
+			static std::vector<Fox::Core::MipImage> Generate(const uint8_t* rgba, uint32_t width, uint32_t height, Fox::Core::MipFilter filter,
+				bool srgb, Fox::Core::ThreadPool* threadPool = nullptr);
+
+		private:
+
+			struct Contribution {
+				uint32_t first = 0u;
+				std::vector<float> weights;
+			};
+
+			static float Evaluate(Fox::Core::MipFilter filter, float x);
+			static float GetRadius(Fox::Core::MipFilter filter);
+			static std::vector<Contribution> ComputeContributions(Fox::Core::MipFilter filter, uint32_t sourceSize, uint32_t targetSize);
+
+			static void Downsample(const std::vector<float>& source, uint32_t width, uint32_t height, std::vector<float>& target,
+				uint32_t targetWidth, uint32_t targetHeight, Fox::Core::MipFilter filter, Fox::Core::ThreadPool* threadPool);
+			static void Quantize(const std::vector<float>& source, uint32_t width, uint32_t height, bool srgb, uint8_t* target);
+		};
+	}
+}
@@ -0,0 +1,82 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Core {
+
+        void RadixSort::Sort(Fox::Core::SortItem* items, Fox::Core::SortItem* scratch, size_t count) {
+            if (count < 2u) {
+                return;
+            }
+
+            uint32_t histograms[8][256] = {};
+            for (size_t i = 0u; i < count; i++) {
+                uint64_t key = items[i].key;
+                for (uint32_t pass = 0u; pass < 8u; pass++) {
+                    histograms[pass][(key >> (pass * 8u)) & 0xFFu]++;
+                }
+            }
+
+            Fox::Core::SortItem* source = items;
+            Fox::Core::SortItem* destination = scratch;
+
+            for (uint32_t pass = 0u; pass < 8u; pass++) {
+                uint32_t* histogram = histograms[pass];
+                uint32_t shift = pass * 8u;
+
+                // every key has the same byte here, the pass would not move anything
+                if (histogram[(source[0].key >> shift) & 0xFFu] == count) {
+                    continue;
+                }
+
+                uint32_t offset = 0u;
+                for (uint32_t digit = 0u; digit < 256u; digit++) {
+                    uint32_t digitCount = histogram[digit];
+                    histogram[digit] = offset;
+                    offset += digitCount;
+                }
+
+                for (size_t i = 0u; i < count; i++) {
+                    destination[histogram[(source[i].key >> shift) & 0xFFu]++] = source[i];
+                }
+
+                std::swap(source, destination);
+            }
+
+            if (source != items) {
+                memcpy(items, source, sizeof(Fox::Core::SortItem) * count);
+            }
+        }
+
+        void RadixSort::Benchmark(uint32_t count) {
+            std::vector<Fox::Core::SortItem> keys(count);
+            std::mt19937_64 random(1234u);
+            for (uint32_t i = 0u; i < count; i++) {
+                keys[i] = { random(), i };
+            }
+
+            std::vector<Fox::Core::SortItem> items = keys;
+            std::vector<Fox::Core::SortItem> scratch(count);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            Sort(items.data(), scratch.data(), items.size());
+            auto end = std::chrono::high_resolution_clock::now();
+            double radixSeconds = std::chrono::duration<double>(end - start).count();
+
+            bool sorted = std::is_sorted(items.begin(), items.end(), [](const Fox::Core::SortItem& a, const Fox::Core::SortItem& b) {
+                return a.key < b.key;
+            });
+
+            items = keys;
+            start = std::chrono::high_resolution_clock::now();
+            std::sort(items.begin(), items.end(), [](const Fox::Core::SortItem& a, const Fox::Core::SortItem& b) {
+                return a.key < b.key;
+            });
+            end = std::chrono::high_resolution_clock::now();
+            double stdSeconds = std::chrono::duration<double>(end - start).count();
+
+            std::cout << "Radix sort: " << count << " keys in " << radixSeconds * 1000.0 << " ms, std::sort " << stdSeconds * 1000.0 << " ms"
+                << (sorted ? "" : " (NOT SORTED)") << std::endl;
+        }
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Fox {
+
+	namespace Core {
+
+		struct SortItem {
+			uint64_t key;
+			uint32_t value;
+		};
+
+		// Least significant digit radix sort of 64-bit keys, one byte per pass. All eight histograms are built in a single
+		// read of the input and passes whose byte is the same for every key are skipped, so keys that only use a few of
+		// their bits cost a few passes. Stable, and it allocates nothing: the caller provides a scratch array of count items.
+		class RadixSort {
+		public:
+			static void Sort(Fox::Core::SortItem* items, Fox::Core::SortItem* scratch, size_t count);
+
+			// sorts count random keys against std::sort and prints both times
+			static void Benchmark(uint32_t count);
+		};
+	}
+}
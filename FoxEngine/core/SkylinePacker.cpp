@@ -0,0 +1,106 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Core {
+
+		SkylinePacker::SkylinePacker(uint32_t width, uint32_t height) {
+			Initialize(width, height);
+		}
+
+		void SkylinePacker::Initialize(uint32_t width, uint32_t height) {
+			this->width = width;
+			this->height = height;
+			usedArea = 0u;
+
+			skyline.clear();
+			skyline.push_back({ 0u, 0u, width });
+		}
+
+		bool SkylinePacker::Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+			if (skyline[index].x + width > this->width) {
+				return false;
+			}
+
+			// the rectangle rests on the highest segment it spans
+			y = 0u;
+			uint32_t remaining = width;
+			for (size_t i = index; remaining > 0u; i++) {
+				y = std::max(y, skyline[i].y);
+				if (y + height > this->height) {
+					return false;
+				}
+				remaining -= std::min(remaining, skyline[i].width);
+			}
+
+			return true;
+		}
+
+		bool SkylinePacker::Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y) {
+			size_t bestIndex = skyline.size();
+			uint32_t bestY = ~0u;
+			uint32_t bestWidth = ~0u;
+
+			for (size_t i = 0u; i < skyline.size(); i++) {
+				uint32_t fitY;
+				if (!Fit(i, width, height, fitY)) {
+					continue;
+				}
+
+				if (fitY < bestY || (fitY == bestY && skyline[i].width < bestWidth)) {
+					bestIndex = i;
+					bestY = fitY;
+					bestWidth = skyline[i].width;
+				}
+			}
+
+			if (bestIndex == skyline.size()) {
+				return false;
+			}
+
+			x = skyline[bestIndex].x;
+			y = bestY;
+
+			skyline.insert(skyline.begin() + bestIndex, { x, y + height, width });
+
+			// segments now covered by the new one are shortened from the left or dropped
+			uint32_t right = x + width;
+			for (size_t i = bestIndex + 1u; i < skyline.size();) {
+				Segment& segment = skyline[i];
+				if (segment.x >= right) {
+					break;
+				}
+
+				uint32_t shrink = right - segment.x;
+				if (segment.width <= shrink) {
+					skyline.erase(skyline.begin() + i);
+					continue;
+				}
+
+				segment.x += shrink;
+				segment.width -= shrink;
+				break;
+			}
+
+			Merge();
+			usedArea += static_cast<uint64_t>(width) * height;
+			return true;
+		}
+
+		void SkylinePacker::Merge() {
+			for (size_t i = 0u; i + 1u < skyline.size();) {
+				if (skyline[i].y == skyline[i + 1u].y) {
+					skyline[i].width += skyline[i + 1u].width;
+					skyline.erase(skyline.begin() + i + 1u);
+				} else {
+					i++;
+				}
+			}
+		}
+
+		float SkylinePacker::GetOccupancy() const {
+			uint64_t area = static_cast<uint64_t>(width) * height;
+			return area > 0u ? static_cast<float>(usedArea) / static_cast<float>(area) : 0.0f;
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Fox {
+
+	namespace Core {
+
+		// Bottom-left skyline rectangle packer. The skyline is the top edge of everything placed so far, a new rectangle goes
+		// where it ends up lowest, ties broken by the narrower segment. Space below the skyline is never reused, which keeps
+		// insertion cheap and is close enough to optimal for texture atlases.
+		class SkylinePacker {
+		public:
+			SkylinePacker() = default;
+			SkylinePacker(uint32_t width, uint32_t height);
+			~SkylinePacker() = default;
+
+			void Initialize(uint32_t width, uint32_t height);
+			bool Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+
+			// fraction of the area covered by inserted rectangles
+			float GetOccupancy() const;
+
+			inline uint32_t GetWidth() const {
+				return width;
+			}
+
+			inline uint32_t GetHeight() const {
+				return height;
+			}
+
+		private:
+
+			struct Segment {
+				uint32_t x = 0u;
+				uint32_t y = 0u;
+				uint32_t width = 0u;
+			};
+
+			// lowest y at which a rectangle starting at the given segment fits
+			bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+			void Merge();
+
+			uint32_t width = 0u;
+			uint32_t height = 0u;
+			uint64_t usedArea = 0u;
+			std::vector<Segment> skyline;
+		};
+	}
+}
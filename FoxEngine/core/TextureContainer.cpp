@@ -0,0 +1,111 @@
+#include "pch.h"
+
+#include <filesystem>
+
+namespace Fox {
+
+	namespace Core {
+
+        static const uint32_t CONTAINER_MAGIC = 0x43545846u; // "FXTC"
+        static const uint32_t CONTAINER_VERSION = 4u;
+
+        // magic, version, format, width, height, levelCount, layerCount, dataOffset, mipFilter
+        static const uint32_t HEADER_SIZE = 9u;
+
+        const std::string TextureContainer::EXTENSION = ".fxtc";
+
+        uint64_t TextureContainer::AlignLevelOffset(uint64_t offset) {
+            return (offset + LEVEL_ALIGNMENT - 1u) & ~(LEVEL_ALIGNMENT - 1u);
+        }
+
+        bool TextureContainer::Map(const std::string& path) {
+            std::shared_ptr<Fox::Core::MappedFile> file = std::make_shared<Fox::Core::MappedFile>();
+
+            if (!file->Open(path) || file->GetSize() < HEADER_SIZE * sizeof(uint32_t)) {
+                return false;
+            }
+
+            uint32_t header[HEADER_SIZE];
+            memcpy(header, file->GetData(), sizeof(header));
+
+            if (header[0] != CONTAINER_MAGIC || header[1] != CONTAINER_VERSION) {
+                return false;
+            }
+
+            uint64_t tableSize = static_cast<uint64_t>(header[5]) * sizeof(Fox::Core::TextureLevel);
+            if (sizeof(header) + tableSize > file->GetSize()) {
+                return false;
+            }
+
+            std::vector<Fox::Core::TextureLevel> table(header[5]);
+            memcpy(table.data(), file->GetData() + sizeof(header), tableSize);
+
+            uint64_t end = table.empty() ? 0u : table.back().offset + table.back().size;
+            if (header[7] + end > file->GetSize()) {
+                return false;
+            }
+
+            format = header[2];
+            width = header[3];
+            height = header[4];
+            layerCount = header[6];
+            mipFilter = header[8];
+            levels = std::move(table);
+            data.clear();
+            mappedFile = file;
+            dataOffset = header[7];
+
+            return true;
+        }
+
+        void TextureContainer::Write(const std::string& path) const {
+            std::filesystem::path filePath(path);
+            if (filePath.has_parent_path()) {
+                std::filesystem::create_directories(filePath.parent_path());
+            }
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+            if (!file.is_open()) {
+                std::cout << "Warning: could not write texture cache " << path << std::endl;
+                return;
+            }
+
+            uint64_t tableEnd = HEADER_SIZE * sizeof(uint32_t) + levels.size() * sizeof(Fox::Core::TextureLevel);
+            uint32_t offset = static_cast<uint32_t>(AlignLevelOffset(tableEnd));
+
+            uint32_t header[HEADER_SIZE] = { CONTAINER_MAGIC, CONTAINER_VERSION, format, width, height, static_cast<uint32_t>(levels.size()), layerCount, offset,
+                mipFilter };
+            file.write(reinterpret_cast<const char*>(header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(levels.data()), levels.size() * sizeof(Fox::Core::TextureLevel));
+
+            // pad so the data block, and with it every level, keeps its alignment in the mapping
+            const char padding[LEVEL_ALIGNMENT] = {};
+            file.write(padding, offset - tableEnd);
+            file.write(reinterpret_cast<const char*>(GetData()), GetDataSize());
+        }
+
+        bool TextureContainer::IsUpToDate(const std::string& containerPath, const std::string& sourcePath) {
+            std::error_code error;
+            auto containerTime = std::filesystem::last_write_time(containerPath, error);
+            if (error) {
+                return false;
+            }
+
+            auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+            // a missing source with a present cache is fine, the cache is all that ships
+            return error || containerTime >= sourceTime;
+        }
+
+        const uint8_t* TextureContainer::GetData() const {
+            return mappedFile ? mappedFile->GetData() + dataOffset : data.data();
+        }
+
+        uint64_t TextureContainer::GetDataSize() const {
+            if (mappedFile) {
+                return levels.empty() ? 0u : levels.back().offset + levels.back().size;
+            }
+            return data.size();
+        }
+	}
+}
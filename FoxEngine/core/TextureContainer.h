@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Fox {
+
+	namespace Core {
+
+		class MappedFile;
+
+		struct TextureLevel {
+			uint32_t width = 0u;
+			uint32_t height = 0u;
+			uint64_t offset = 0u;	// from the start of the data block, aligned to LEVEL_ALIGNMENT
+			uint64_t size = 0u;		// all layers of the level, layer i starts at offset + i * size / layerCount
+		};
+
+		// GPU-ready texture file: every level already in its final format with all array layers back to back, the same layout
+		// vkCmdCopyBufferToImage expects with a tightly packed region per level. Mapped containers read straight from the file pages.
+		class TextureContainer {
+		public:
+			TextureContainer() = default;
+			~TextureContainer() = default;
+
+			// maps the file, nothing is read or decoded until GetData is touched
+			bool Map(const std::string& path);
+			void Write(const std::string& path) const;
+
+			// true when the cooked file exists and is newer than its source
+			static bool IsUpToDate(const std::string& containerPath, const std::string& sourcePath);
+			static uint64_t AlignLevelOffset(uint64_t offset);
+
+			const uint8_t* GetData() const;
+			uint64_t GetDataSize() const;
+
+			static const std::string EXTENSION;
+			static const uint64_t LEVEL_ALIGNMENT = 16u;
+
+			uint32_t format = 0u;
+			uint32_t width = 0u;
+			uint32_t height = 0u;
+			uint32_t layerCount = 1u;
+			uint32_t mipFilter = 0u;	// the Fox::Core::MipFilter the levels were generated with
+			std::vector<Fox::Core::TextureLevel> levels;
+			// owned data of a container cooked in memory, empty for mapped containers
+			std::vector<uint8_t> data;
+
+		private:
+			std::shared_ptr<Fox::Core::MappedFile> mappedFile;
+			uint64_t dataOffset = 0u;
+		};
+	}
+}
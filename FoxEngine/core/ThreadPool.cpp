@@ -0,0 +1,105 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Core {
+
+		ThreadPool::ThreadPool(uint32_t numThreads) {
+			if (numThreads == 0u) {
+				uint32_t hardwareThreads = std::thread::hardware_concurrency();
+				numThreads = hardwareThreads > 1u ? hardwareThreads - 1u : 1u;
+			}
+
+			for (uint32_t i = 0u; i < numThreads; i++) {
+				workers.emplace_back(&ThreadPool::WorkerLoop, this);
+			}
+		}
+
+		ThreadPool::~ThreadPool() {
+			{
+				std::lock_guard<std::mutex> lock(tasksMutex);
+				stopping = true;
+			}
+			tasksAvailable.notify_all();
+
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		}
+
+		void ThreadPool::WorkerLoop() {
+			while (true) {
+				std::function<void()> task;
+				{
+					std::unique_lock<std::mutex> lock(tasksMutex);
+					tasksAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+					if (stopping && tasks.empty()) {
+						return;
+					}
+
+					task = std::move(tasks.front());
+					tasks.pop();
+				}
+				task();
+			}
+		}
+
+		void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function) {
+			if (count == 0u) {
+				return;
+			}
+
+			struct SharedState {
+				std::atomic<uint32_t> nextIndex{ 0u };
+				std::atomic<uint32_t> completed{ 0u };
+				std::mutex doneMutex;
+				std::condition_variable done;
+				std::atomic<bool> failed{ false };
+				std::exception_ptr error;
+			};
+
+			auto state = std::make_shared<SharedState>();
+
+			// helpers only claim indices, so the caller never waits on a task that could not be scheduled
+			auto work = [state, count, &function]() {
+				uint32_t index;
+				while ((index = state->nextIndex.fetch_add(1u)) < count) {
+					// an exception must neither end a worker nor leave the caller before every index is accounted for
+					if (!state->failed.load()) {
+						try {
+							function(index);
+						} catch (...) {
+							std::lock_guard<std::mutex> lock(state->doneMutex);
+							if (!state->failed.exchange(true)) {
+								state->error = std::current_exception();
+							}
+						}
+					}
+					if (state->completed.fetch_add(1u) + 1u == count) {
+						std::lock_guard<std::mutex> lock(state->doneMutex);
+						state->done.notify_all();
+					}
+				}
+			};
+
+			uint32_t numHelpers = std::min(GetThreadCount(), count - 1u);
+			{
+				std::lock_guard<std::mutex> lock(tasksMutex);
+				for (uint32_t i = 0u; i < numHelpers; i++) {
+					tasks.push(work);
+				}
+			}
+			tasksAvailable.notify_all();
+
+			work();
+
+			std::unique_lock<std::mutex> lock(state->doneMutex);
+			state->done.wait(lock, [&state, count]() { return state->completed.load() == count; });
+
+			if (state->error) {
+				std::rethrow_exception(state->error);
+			}
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Fox {
+
+	namespace Core {
+
+		class ThreadPool {
+		public:
+			ThreadPool(uint32_t numThreads = 0u);
+			~ThreadPool();
+
+			template<class Function>
+			std::future<void> Submit(Function&& function);
+
+			// Runs function(index) for every index in [0, count) on the workers and the calling thread, returns when all are done.
+			// The first exception thrown is rethrown on the calling thread after that, the indices not started by then are skipped.
+			void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function);
+
+			inline uint32_t GetThreadCount() const {
+				return static_cast<uint32_t>(workers.size());
+			}
+
+		private:
+			void WorkerLoop();
+
+			std::vector<std::thread> workers;
+			std::queue<std::function<void()>> tasks;
+			std::mutex tasksMutex;
+			std::condition_variable tasksAvailable;
+			bool stopping = false;
+		};
+
+		template<class Function>
+		std::future<void> ThreadPool::Submit(Function&& function) {
+			auto task = std::make_shared<std::packaged_task<void()>>(std::forward<Function>(function));
+			std::future<void> result = task->get_future();
+			{
+				std::lock_guard<std::mutex> lock(tasksMutex);
+				tasks.push([task]() { (*task)(); });
+			}
+			tasksAvailable.notify_one();
+			return result;
+		}
+	}
+}
@@ -0,0 +1,264 @@
+#include "pch.h"
+
+#include <bit>
+
+namespace Fox {
+
+	namespace Core {
+
+		TlsfAllocator::TlsfAllocator(uint64_t capacity) {
+			Initialize(capacity);
+		}
+
+		void TlsfAllocator::Initialize(uint64_t capacity) {
+			this->capacity = capacity;
+			usedBytes = 0u;
+			allocationCount = 0u;
+
+			blocks.clear();
+			unusedBlocks.clear();
+			flBitmap = 0u;
+
+			for (uint32_t fl = 0u; fl < FL_COUNT; fl++) {
+				slBitmap[fl] = 0u;
+				for (uint32_t sl = 0u; sl < SL_COUNT; sl++) {
+					freeLists[fl][sl] = INVALID_HANDLE;
+				}
+			}
+
+			if (capacity == 0u) {
+				return;
+			}
+
+			uint32_t blockIndex = NewBlock();
+			blocks[blockIndex].offset = 0u;
+			blocks[blockIndex].size = capacity;
+			InsertFreeBlock(blockIndex);
+		}
+
+		void TlsfAllocator::Mapping(uint64_t size, uint32_t& fl, uint32_t& sl) {
+			if (size < SL_COUNT) {
+				fl = 0u;
+				sl = static_cast<uint32_t>(size);
+				return;
+			}
+
+			uint32_t msb = static_cast<uint32_t>(std::bit_width(size)) - 1u;
+			fl = msb - SL_COUNT_LOG2 + 1u;
+			sl = static_cast<uint32_t>(size >> (msb - SL_COUNT_LOG2)) ^ SL_COUNT;
+		}
+
+		void TlsfAllocator::MappingSearch(uint64_t size, uint32_t& fl, uint32_t& sl) {
+			// round up to the next list so that every block found is guaranteed to be large enough
+			if (size >= SL_COUNT) {
+				uint32_t msb = static_cast<uint32_t>(std::bit_width(size)) - 1u;
+				size += (1ull << (msb - SL_COUNT_LOG2)) - 1u;
+			}
+			Mapping(size, fl, sl);
+		}
+
+		uint32_t TlsfAllocator::NewBlock() {
+			if (!unusedBlocks.empty()) {
+				uint32_t blockIndex = unusedBlocks.back();
+				unusedBlocks.pop_back();
+				blocks[blockIndex] = Block();
+				return blockIndex;
+			}
+
+			blocks.push_back(Block());
+			return static_cast<uint32_t>(blocks.size() - 1u);
+		}
+
+		void TlsfAllocator::ReleaseBlock(uint32_t blockIndex) {
+			blocks[blockIndex].size = 0u;
+			unusedBlocks.push_back(blockIndex);
+		}
+
+		void TlsfAllocator::InsertFreeBlock(uint32_t blockIndex) {
+			Block& block = blocks[blockIndex];
+			uint32_t fl, sl;
+			Mapping(block.size, fl, sl);
+
+			block.free = true;
+			block.prevFree = INVALID_HANDLE;
+			block.nextFree = freeLists[fl][sl];
+
+			if (block.nextFree != INVALID_HANDLE) {
+				blocks[block.nextFree].prevFree = blockIndex;
+			}
+
+			freeLists[fl][sl] = blockIndex;
+			flBitmap |= 1ull << fl;
+			slBitmap[fl] |= 1u << sl;
+		}
+
+		void TlsfAllocator::RemoveFreeBlock(uint32_t blockIndex) {
+			Block& block = blocks[blockIndex];
+			uint32_t fl, sl;
+			Mapping(block.size, fl, sl);
+
+			if (block.prevFree != INVALID_HANDLE) {
+				blocks[block.prevFree].nextFree = block.nextFree;
+			} else {
+				freeLists[fl][sl] = block.nextFree;
+			}
+
+			if (block.nextFree != INVALID_HANDLE) {
+				blocks[block.nextFree].prevFree = block.prevFree;
+			}
+
+			if (freeLists[fl][sl] == INVALID_HANDLE) {
+				slBitmap[fl] &= ~(1u << sl);
+				if (slBitmap[fl] == 0u) {
+					flBitmap &= ~(1ull << fl);
+				}
+			}
+
+			block.free = false;
+			block.prevFree = INVALID_HANDLE;
+			block.nextFree = INVALID_HANDLE;
+		}
+
+		uint32_t TlsfAllocator::FindFreeBlock(uint64_t size) {
+			uint32_t fl, sl;
+			MappingSearch(size, fl, sl);
+
+			if (fl >= FL_COUNT) {
+				return INVALID_HANDLE;
+			}
+
+			uint32_t slMap = sl < SL_COUNT ? slBitmap[fl] & (~0u << sl) : 0u;
+
+			if (slMap == 0u) {
+				uint64_t flMap = fl + 1u < FL_COUNT ? flBitmap & (~0ull << (fl + 1u)) : 0u;
+				if (flMap == 0u) {
+					return INVALID_HANDLE;
+				}
+				fl = static_cast<uint32_t>(std::countr_zero(flMap));
+				slMap = slBitmap[fl];
+			}
+
+			sl = static_cast<uint32_t>(std::countr_zero(slMap));
+			return freeLists[fl][sl];
+		}
+
+		uint32_t TlsfAllocator::SplitBlock(uint32_t blockIndex, uint64_t size) {
+			uint32_t remainderIndex = NewBlock();
+			Block& block = blocks[blockIndex];
+			Block& remainder = blocks[remainderIndex];
+
+			remainder.offset = block.offset + size;
+			remainder.size = block.size - size;
+			remainder.prevPhysical = blockIndex;
+			remainder.nextPhysical = block.nextPhysical;
+
+			if (block.nextPhysical != INVALID_HANDLE) {
+				blocks[block.nextPhysical].prevPhysical = remainderIndex;
+			}
+
+			block.size = size;
+			block.nextPhysical = remainderIndex;
+
+			return remainderIndex;
+		}
+
+		bool TlsfAllocator::Allocate(uint64_t size, uint64_t alignment, Allocation& allocation) {
+			if (size == 0u) {
+				return false;
+			}
+
+			if (alignment == 0u) {
+				alignment = 1u;
+			}
+
+			uint32_t blockIndex = FindFreeBlock(size + alignment - 1u);
+			if (blockIndex == INVALID_HANDLE) {
+				return false;
+			}
+
+			RemoveFreeBlock(blockIndex);
+
+			uint64_t alignedOffset = (blocks[blockIndex].offset + alignment - 1u) / alignment * alignment;
+			uint64_t padding = alignedOffset - blocks[blockIndex].offset;
+
+			if (padding > 0u) {
+				uint32_t alignedIndex = SplitBlock(blockIndex, padding);
+				InsertFreeBlock(blockIndex);
+				blockIndex = alignedIndex;
+			}
+
+			if (blocks[blockIndex].size > size) {
+				uint32_t remainderIndex = SplitBlock(blockIndex, size);
+				InsertFreeBlock(remainderIndex);
+			}
+
+			blocks[blockIndex].free = false;
+
+			allocation.offset = blocks[blockIndex].offset;
+			allocation.size = blocks[blockIndex].size;
+			allocation.handle = blockIndex;
+
+			usedBytes += allocation.size;
+			allocationCount++;
+
+			return true;
+		}
+
+		void TlsfAllocator::Free(Allocation& allocation) {
+			if (!allocation.IsValid()) {
+				return;
+			}
+
+			uint32_t blockIndex = allocation.handle;
+
+			usedBytes -= blocks[blockIndex].size;
+			allocationCount--;
+
+			uint32_t prevIndex = blocks[blockIndex].prevPhysical;
+			if (prevIndex != INVALID_HANDLE && blocks[prevIndex].free) {
+				RemoveFreeBlock(prevIndex);
+				blocks[prevIndex].size += blocks[blockIndex].size;
+				blocks[prevIndex].nextPhysical = blocks[blockIndex].nextPhysical;
+				if (blocks[blockIndex].nextPhysical != INVALID_HANDLE) {
+					blocks[blocks[blockIndex].nextPhysical].prevPhysical = prevIndex;
+				}
+				ReleaseBlock(blockIndex);
+				blockIndex = prevIndex;
+			}
+
+			uint32_t nextIndex = blocks[blockIndex].nextPhysical;
+			if (nextIndex != INVALID_HANDLE && blocks[nextIndex].free) {
+				RemoveFreeBlock(nextIndex);
+				blocks[blockIndex].size += blocks[nextIndex].size;
+				blocks[blockIndex].nextPhysical = blocks[nextIndex].nextPhysical;
+				if (blocks[nextIndex].nextPhysical != INVALID_HANDLE) {
+					blocks[blocks[nextIndex].nextPhysical].prevPhysical = blockIndex;
+				}
+				ReleaseBlock(nextIndex);
+			}
+
+			InsertFreeBlock(blockIndex);
+
+			allocation = Allocation();
+		}
+
+		Fox::Core::AllocatorStatistics TlsfAllocator::GetStatistics() const {
+			Fox::Core::AllocatorStatistics statistics;
+			statistics.capacity = capacity;
+			statistics.usedBytes = usedBytes;
+			statistics.freeBytes = capacity - usedBytes;
+			statistics.allocationCount = allocationCount;
+
+			for (uint32_t fl = 0u; fl < FL_COUNT; fl++) {
+				for (uint32_t sl = 0u; sl < SL_COUNT; sl++) {
+					for (uint32_t blockIndex = freeLists[fl][sl]; blockIndex != INVALID_HANDLE; blockIndex = blocks[blockIndex].nextFree) {
+						statistics.freeBlockCount++;
+						statistics.largestFreeBlock = std::max(statistics.largestFreeBlock, blocks[blockIndex].size);
+					}
+				}
+			}
+
+			return statistics;
+		}
+	}
+}
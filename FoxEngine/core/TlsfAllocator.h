@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Fox {
+
+	namespace Core {
+
+		struct AllocatorStatistics {
+			uint64_t capacity = 0u;
+			uint64_t usedBytes = 0u;
+			uint64_t freeBytes = 0u;
+			uint64_t largestFreeBlock = 0u;
+			uint32_t allocationCount = 0u;
+			uint32_t freeBlockCount = 0u;
+
+			float GetOccupancy() const {
+				return capacity > 0u ? static_cast<float>(usedBytes) / static_cast<float>(capacity) : 0.0f;
+			}
+
+			// 0 when all free space is one contiguous range, approaching 1 as it is split into small holes
+			float GetFragmentation() const {
+				return freeBytes > 0u ? 1.0f - static_cast<float>(largestFreeBlock) / static_cast<float>(freeBytes) : 0.0f;
+			}
+		};
+
+		// Two-level segregated fit allocator over an abstract address range. It never touches the
+		// memory it manages, so the same allocator serves GPU buffers, device memory blocks and staging rings.
+		class TlsfAllocator {
+		public:
+
+			static constexpr uint32_t INVALID_HANDLE = ~0u;
+
+			struct Allocation {
+				uint64_t offset = 0u;
+				uint64_t size = 0u;
+				uint32_t handle = INVALID_HANDLE;
+
+				bool IsValid() const {
+					return handle != INVALID_HANDLE;
+				}
+			};
+
+			TlsfAllocator() = default;
+			TlsfAllocator(uint64_t capacity);
+			~TlsfAllocator() = default;
+
+			void Initialize(uint64_t capacity);
+			bool Allocate(uint64_t size, uint64_t alignment, Allocation& allocation);
+			void Free(Allocation& allocation);
+
+			Fox::Core::AllocatorStatistics GetStatistics() const;
+
+			inline uint64_t GetCapacity() const {
+				return capacity;
+			}
+
+			inline uint64_t GetUsedBytes() const {
+				return usedBytes;
+			}
+
+			inline bool IsEmpty() const {
+				return allocationCount == 0u;
+			}
+
+		private:
+
+			static constexpr uint32_t SL_COUNT_LOG2 = 5u;
+			static constexpr uint32_t SL_COUNT = 1u << SL_COUNT_LOG2;
+			static constexpr uint32_t FL_COUNT = 64u;
+
+			struct Block {
+				uint64_t offset = 0u;
+				uint64_t size = 0u;
+				uint32_t prevPhysical = INVALID_HANDLE;
+				uint32_t nextPhysical = INVALID_HANDLE;
+				uint32_t prevFree = INVALID_HANDLE;
+				uint32_t nextFree = INVALID_HANDLE;
+				bool free = false;
+			};
+
+			static void Mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+			static void MappingSearch(uint64_t size, uint32_t& fl, uint32_t& sl);
+
+			uint32_t NewBlock();
+			void ReleaseBlock(uint32_t blockIndex);
+			void InsertFreeBlock(uint32_t blockIndex);
+			void RemoveFreeBlock(uint32_t blockIndex);
+			uint32_t FindFreeBlock(uint64_t size);
+			uint32_t SplitBlock(uint32_t blockIndex, uint64_t size);
+
+			std::vector<Block> blocks;
+			std::vector<uint32_t> unusedBlocks;
+
+			uint64_t flBitmap = 0u;
+			uint32_t slBitmap[FL_COUNT] = {};
+			uint32_t freeLists[FL_COUNT][SL_COUNT];
+
+			uint64_t capacity = 0u;
+			uint64_t usedBytes = 0u;
+			uint32_t allocationCount = 0u;
+		};
+	}
+}
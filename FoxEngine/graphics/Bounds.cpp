@@ -0,0 +1,63 @@
+#include "pch.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FOX_BOUNDS_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Fox {
+
+	namespace Vulkan {
+
+        Bounds Bounds::Compute(const std::vector<Fox::Vulkan::Vertex>& vertices) {
+            Bounds bounds;
+
+            if (vertices.empty()) {
+                return bounds;
+            }
+
+#ifdef FOX_BOUNDS_SSE
+            static_assert(offsetof(Fox::Vulkan::Vertex, pos) + 4 * sizeof(float) <= sizeof(Fox::Vulkan::Vertex), "Position load reads past the vertex!");
+
+            // the fourth lane picks up the following attribute and is ignored
+            __m128 minimum = _mm_loadu_ps(&vertices[0].pos.x);
+            __m128 maximum = minimum;
+
+            for (size_t i = 1u; i < vertices.size(); i++) {
+                __m128 position = _mm_loadu_ps(&vertices[i].pos.x);
+                minimum = _mm_min_ps(minimum, position);
+                maximum = _mm_max_ps(maximum, position);
+            }
+
+            alignas(16) float minValues[4];
+            alignas(16) float maxValues[4];
+            _mm_store_ps(minValues, minimum);
+            _mm_store_ps(maxValues, maximum);
+
+            bounds.box.min = glm::vec3(minValues[0], minValues[1], minValues[2]);
+            bounds.box.max = glm::vec3(maxValues[0], maxValues[1], maxValues[2]);
+#else
+            bounds.box.min = vertices[0].pos;
+            bounds.box.max = vertices[0].pos;
+
+            for (const auto& vertex : vertices) {
+                bounds.box.min = glm::min(bounds.box.min, vertex.pos);
+                bounds.box.max = glm::max(bounds.box.max, vertex.pos);
+            }
+#endif
+
+            glm::vec3 center = bounds.box.GetCenter();
+            float maxDistanceSquared = 0.0f;
+
+            for (const auto& vertex : vertices) {
+                glm::vec3 offset = vertex.pos - center;
+                maxDistanceSquared = std::max(maxDistanceSquared, glm::dot(offset, offset));
+            }
+
+            bounds.sphere.center = center;
+            bounds.sphere.radius = std::sqrt(maxDistanceSquared);
+
+            return bounds;
+        }
+	}
+}
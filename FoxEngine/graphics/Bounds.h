@@ -0,0 +1,61 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		struct BoundingBox {
+			glm::vec3 min = glm::vec3(0.0f);
+			glm::vec3 max = glm::vec3(0.0f);
+
+			glm::vec3 GetCenter() const {
+				return (min + max) * 0.5f;
+			}
+
+			glm::vec3 GetExtents() const {
+				return (max - min) * 0.5f;
+			}
+
+			// Arvo's method in center/extents form: the new extents are |M| * extents, no need to transform all eight corners
+			BoundingBox Transform(const glm::mat4& matrix) const {
+				glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+
+				glm::mat3 absolute = glm::mat3(matrix);
+				for (int i = 0; i < 3; i++) {
+					absolute[i] = glm::abs(absolute[i]);
+				}
+				glm::vec3 extents = absolute * GetExtents();
+
+				BoundingBox box;
+				box.min = center - extents;
+				box.max = center + extents;
+				return box;
+			}
+		};
+
+		struct BoundingSphere {
+			glm::vec3 center = glm::vec3(0.0f);
+			float radius = 0.0f;
+
+			BoundingSphere Transform(const glm::mat4& matrix) const {
+				float maxScale = std::max(glm::length(glm::vec3(matrix[0])), std::max(glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2]))));
+
+				BoundingSphere sphere;
+				sphere.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+				sphere.radius = radius * maxScale;
+				return sphere;
+			}
+		};
+
+		struct Bounds {
+			Fox::Vulkan::BoundingBox box;
+			Fox::Vulkan::BoundingSphere sphere;
+
+			Bounds Transform(const glm::mat4& matrix) const {
+				return { box.Transform(matrix), sphere.Transform(matrix) };
+			}
+
+			static Bounds Compute(const std::vector<Fox::Vulkan::Vertex>& vertices);
+		};
+	}
+}
@@ -6,47 +6,103 @@ namespace Fox {
 
         class Renderer;
 
+		// Owns a VkBuffer and its memory. Host visible buffers stay mapped for their whole lifetime and are written in place,
+		// device local ones are filled through the staging pool. No CPU copy of the contents is kept, only the element count.
+		// Buffers can be moved but not copied.
 		template<class T>
 		class Buffer {
-		public: 
+		public:
 			Buffer() {}
+			Buffer(const Buffer&) = delete;
+			Buffer& operator=(const Buffer&) = delete;
+			Buffer(Buffer&& other) noexcept;
+			Buffer& operator=(Buffer&& other) noexcept;
 		    ~Buffer();
 
-			void Create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+			// dedicated keeps the buffer out of the allocator's blocks, for long-lived buffers that are never relocated
+			void Create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, bool dedicated = false);
 			void CopyImage(VkDeviceSize imageSize, unsigned char* pixels);
-			void CopyData(std::vector<T>& data, VkDeviceSize size);
-			void Map();
-			void Update(T& data);
+			void CopyData(const std::vector<T>& data, VkDeviceSize size);
+			// writes count elements starting at element firstElement, the buffer has to be host visible
+			void Write(const T* data, size_t count, size_t firstElement = 0u);
+			void Update(const T& data);
+			// device local buffers need VK_BUFFER_USAGE_TRANSFER_DST_BIT for this
             void SetContents(const std::vector<T>& content, bool sendToGPU = true);
             size_t GetElementCount() const {
-                return content.size();
+                return elementCount;
             }
 
 			VkBuffer GetBuffer() {
 				return buffer;
 			}
 
-		protected: 
-			VkBuffer buffer;
-			VkDeviceMemory bufferMemory;
-			VkDeviceSize size;
+			VkDeviceSize GetSize() const {
+				return size;
+			}
+
+			inline bool IsHostVisible() const {
+				return allocation.mappedMemory != nullptr;
+			}
+
+			// null for device local memory
+			void* GetMappedMemory() {
+				return allocation.mappedMemory;
+			}
+
+		protected:
+			void Destroy();
 
-            std::vector<T> content;
-			void* mappedMemory;
+			VkBuffer buffer = VK_NULL_HANDLE;
+			Fox::Vulkan::MemoryAllocation allocation;
+			VkDeviceSize size = 0u;
+			size_t elementCount = 0u;
 		};
 
+        template<class T>
+        Buffer<T>::Buffer(Buffer&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        template<class T>
+        Buffer<T>& Buffer<T>::operator=(Buffer&& other) noexcept {
+            if (this != &other) {
+                Destroy();
+                buffer = std::exchange(other.buffer, VK_NULL_HANDLE);
+                allocation = std::exchange(other.allocation, Fox::Vulkan::MemoryAllocation());
+                size = std::exchange(other.size, 0u);
+                elementCount = std::exchange(other.elementCount, 0u);
+            }
+            return *this;
+        }
+
         template<class T>
         Buffer<T>::~Buffer() {
+            Destroy();
+        }
+
+        template<class T>
+        void Buffer<T>::Destroy() {
+            if (buffer == VK_NULL_HANDLE) {
+                return;
+            }
+
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
             vkDestroyBuffer(device, buffer, nullptr);
-            vkFreeMemory(device, bufferMemory, nullptr);
+            buffer = VK_NULL_HANDLE;
+
+            Fox::Vulkan::MemoryAllocator* memoryAllocator = Fox::Vulkan::Renderer::GetRenderer()->GetMemoryAllocator();
+            if (memoryAllocator) {
+                memoryAllocator->Free(allocation);
+            }
         }
 
         template<class T>
-        void Buffer<T>::Create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties) {
+        void Buffer<T>::Create(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, bool dedicated) {
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
 
+            Destroy();
             this->size = size;
+            elementCount = static_cast<size_t>(size / sizeof(T));
 
             VkBufferCreateInfo bufferInfo{};
             bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -58,60 +114,50 @@ namespace Fox {
                 throw std::runtime_error("failed to create buffer!");
             }
 
-            VkMemoryRequirements memRequirements;
-            vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
-
-            VkMemoryAllocateInfo allocInfo{};
-            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocInfo.allocationSize = memRequirements.size;
-            allocInfo.memoryTypeIndex = Fox::Vulkan::Renderer::GetRenderer()->findMemoryType(memRequirements.memoryTypeBits, properties);
-
-            if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-                throw std::runtime_error("failed to allocate buffer memory!");
-            }
-
-            vkBindBufferMemory(device, buffer, bufferMemory, 0);
+            allocation = Fox::Vulkan::Renderer::GetRenderer()->GetMemoryAllocator()->AllocateForBuffer(buffer, properties,
+                Fox::Vulkan::MemoryAllocator::GetBufferCategory(usage), dedicated);
         }
 
+        // host visible memory is mapped by the allocator for as long as it lives, the copies write straight into it
         template<class T>
         void Buffer<T>::CopyImage(VkDeviceSize imageSize, unsigned char* pixels) {
-            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
-            void* data;
-            vkMapMemory(device, bufferMemory, 0, imageSize, 0, &data);
-            memcpy(data, pixels, static_cast<size_t>(imageSize));
-            vkUnmapMemory(device, bufferMemory);
+            memcpy(allocation.mappedMemory, pixels, static_cast<size_t>(imageSize));
         }
 
         template<class T>
-        void Buffer<T>::Map() {
-            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
-            vkMapMemory(device, bufferMemory, 0, size, 0, &mappedMemory);
-
+        void Buffer<T>::CopyData(const std::vector<T>& data, VkDeviceSize bufferSize) {
+            memcpy(allocation.mappedMemory, data.data(), (size_t)bufferSize);
         }
 
         template<class T>
-        void Buffer<T>::CopyData(std::vector<T>& data, VkDeviceSize bufferSize) {
-            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
-            vkMapMemory(device, bufferMemory, 0, bufferSize, 0, &mappedMemory);
-            memcpy(mappedMemory, data.data(), (size_t)bufferSize);
-            vkUnmapMemory(device, bufferMemory);
+        void Buffer<T>::Write(const T* data, size_t count, size_t firstElement) {
+            memcpy(static_cast<T*>(allocation.mappedMemory) + firstElement, data, sizeof(T) * count);
         }
 
         template<class T>
-        void Buffer<T>::Update(T& data) {
-            memcpy(mappedMemory, &data, sizeof(data));
+        void Buffer<T>::Update(const T& data) {
+            memcpy(allocation.mappedMemory, &data, sizeof(data));
         }
 
         template<class T>
         void Buffer<T>::SetContents(const std::vector<T>& contents, bool sendToGPU) {
-            content.resize(contents.size());
-            std::copy(contents.begin(), contents.end(), content.begin());
-            size = sizeof(T) * content.size();
-            if (sendToGPU) {
-                CopyData(content, size);
+            elementCount = contents.size();
+            if (!sendToGPU || contents.empty()) {
+                return;
+            }
+
+            VkDeviceSize contentSize = sizeof(T) * contents.size();
+            if (IsHostVisible()) {
+                memcpy(allocation.mappedMemory, contents.data(), static_cast<size_t>(contentSize));
+                return;
             }
 
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            Fox::Vulkan::StagingAllocation staging = renderer->GetStagingPool()->Allocate(contentSize);
+            memcpy(staging.data, contents.data(), static_cast<size_t>(contentSize));
+            renderer->CopyBuffer(staging.buffer, buffer, contentSize, staging.offset, 0);
+            renderer->GetStagingPool()->Free(staging);
         }
 
 	}
-}
\ No newline at end of file
+}
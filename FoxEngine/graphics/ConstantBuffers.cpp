@@ -4,33 +4,17 @@ namespace Fox {
 
 	namespace Vulkan {
 
-        ConstantBuffers::~ConstantBuffers() {
-            DeleteBuffers();
-        }
-
         void ConstantBuffers::CreateUniformBuffers(uint32_t maxFramesInFlight) {
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
             VkDeviceSize bufferSize = sizeof(Fox::Vulkan::PerFrameConstantBuffer);
 
-            perFrame.resize(maxFramesInFlight);
+            perFrame.clear();
+            perFrame.reserve(maxFramesInFlight);
 
             for (size_t i = 0; i < maxFramesInFlight; i++) {
-
-                Fox::Vulkan::Buffer<Fox::Vulkan::PerFrameConstantBuffer>* uniformBuffer = new Fox::Vulkan::Buffer<Fox::Vulkan::PerFrameConstantBuffer>();
-                uniformBuffer->Create(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-                uniformBuffer->Map();
-                perFrame[i] = uniformBuffer;
-
-            }
-
-            VkDeviceSize perObjectBufferSize = sizeof(Fox::Vulkan::PerObjectConstantBuffer);
-            perObject.resize(maxFramesInFlight);
-
-            for (size_t i = 0u; i < maxFramesInFlight; i++) {
-                Fox::Vulkan::Buffer<Fox::Vulkan::PerObjectConstantBuffer>* uniformBuffer = new Fox::Vulkan::Buffer<Fox::Vulkan::PerObjectConstantBuffer>();
-                uniformBuffer->Create(perObjectBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-                uniformBuffer->Map();
-                perObject[i] = uniformBuffer;
+                Fox::Vulkan::Buffer<Fox::Vulkan::PerFrameConstantBuffer> uniformBuffer;
+                uniformBuffer.Create(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                perFrame.push_back(std::move(uniformBuffer));
             }
         }
 		
@@ -47,30 +31,67 @@ namespace Fox {
             Fox::Vulkan::PerFrameConstantBuffer perFrame{};
             perFrame.model = glm::rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
             perFrame.view = glm::lookAt(glm::vec3(0.0f, -3.0f, 3.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-            perFrame.proj = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 10.0f);
+            perFrame.proj = glm::perspective(glm::radians(45.0f), aspectRatio, nearPlane, farPlane);
             perFrame.proj[1][1] *= -1;
 
 
-            this->perFrame[currentImage]->Update(perFrame);
+            this->perFrame[currentImage].Update(perFrame);
+            view = perFrame.view;
+
+            RequestTextureDetail(perFrame.view, perFrame.proj, static_cast<float>(renderer->swapchain->GetExtent().height));
 
         }	
 
-        void ConstantBuffers::SyncPerObject(uint32_t currentFrame, const Batch& batch) {
-            Fox::Vulkan::PerObjectConstantBuffer perObject{};
-            perObject.model = batch.matrix;
+        void ConstantBuffers::RequestTextureDetail(const glm::mat4& view, const glm::mat4& proj, float viewportHeight) {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            Fox::Vulkan::TextureManager* textureManager = renderer->GetTextureManager();
 
-            this->perObject[currentFrame]->Update(perObject);
+            if (!renderer->sceneGraph) {
+                return;
+            }
+
+            // projected diameter of the bounding sphere, proj[1][1] is the cotangent of half the vertical field of view
+            float projectionScale = std::abs(proj[1][1]) * viewportHeight;
+
+            renderer->sceneGraph->ForEach([&](std::shared_ptr<Fox::Vulkan::SceneNode> node) {
+                Fox::Vulkan::ModelNode* modelNode = dynamic_cast<Fox::Vulkan::ModelNode*>(node.get());
+                if (!modelNode || !modelNode->HasWorldBounds() || !modelNode->GetModel() || !modelNode->GetModel()->GetTexture()) {
+                    return;
+                }
+
+                const Fox::Vulkan::BoundingSphere& sphere = modelNode->GetWorldBounds().sphere;
+                float distance = -(view * glm::vec4(sphere.center, 1.0f)).z;
+
+                if (distance < -sphere.radius) {
+                    return;
+                }
+
+                float pixels = distance > sphere.radius ? sphere.radius * projectionScale / distance : std::numeric_limits<float>::max();
+                textureManager->RequestScreenSize(modelNode->GetModel()->GetTexture(), pixels);
+            });
         }
 
-        void ConstantBuffers::DeleteBuffers() {
+        VkBuffer ConstantBuffers::GetPerObjectConstantBuffer() {
+            return Fox::Vulkan::Renderer::GetRenderer()->GetUploadRing()->GetBuffer();
+        }
 
-            for (size_t i = 0u; i < perFrame.size(); i++) {
-                delete perFrame[i];
-            }
+        Fox::Vulkan::PerObjectConstantBuffer ConstantBuffers::GetPerObjectData(const Fox::Vulkan::InstancedBatch& batch) {
+            Fox::Vulkan::PerObjectConstantBuffer perObject{};
+            perObject.texCoordTransform = batch.model->GetTextureRegion().texCoordTransform;
+            perObject.textureLayer = batch.model->GetTextureRegion().layer;
+            perObject.textureIndex = batch.textureIndex;
+            return perObject;
+        }
 
-            for (size_t i = 0u; i < perObject.size(); i++) {
-                delete perObject[i];
+        bool ConstantBuffers::SyncPerObject(const Fox::Vulkan::InstancedBatch& batch, uint32_t& dynamicOffset) {
+            Fox::Vulkan::UploadAllocation allocation = Fox::Vulkan::Renderer::GetRenderer()->GetUploadRing()->AllocateUniform(sizeof(Fox::Vulkan::PerObjectConstantBuffer));
+            if (!allocation.IsValid()) {
+                return false;
             }
+
+            *static_cast<Fox::Vulkan::PerObjectConstantBuffer*>(allocation.data) = GetPerObjectData(batch);
+            dynamicOffset = static_cast<uint32_t>(allocation.offset);
+            return true;
         }
 		
 	}
@@ -3,31 +3,53 @@
 namespace Fox {
 
 	namespace Vulkan {
+
+		struct InstancedBatch;
+
 		class ConstantBuffers {
 		
 		public:
 
 			ConstantBuffers() = default;
-			~ConstantBuffers();
+			~ConstantBuffers() = default;
 
 			inline VkBuffer GetPerFrameConstantBuffer(uint32_t imageIndex) {
-				return perFrame[imageIndex]->GetBuffer();
+				return perFrame[imageIndex].GetBuffer();
 			}
 
-			inline VkBuffer GetPerObjectConstantBuffer(uint32_t imageIndex) {
-				return perObject[imageIndex]->GetBuffer();
-			}
+			// Per-object data lives in the upload ring, one aligned slot per draw, and is bound as a dynamic uniform buffer.
+			// The descriptor covers a single slot at offset 0 of the ring, every draw passes its slot as the dynamic offset.
+			VkBuffer GetPerObjectConstantBuffer();
 
 			void CreateUniformBuffers(uint32_t maxFramesInFlight);
 			void SyncPerFrame(uint32_t currentFrame);
-			void SyncPerObject(uint32_t currentFrame, const Batch& batch);
+
+			// camera of the last SyncPerFrame
+			inline const glm::mat4& GetView() const {
+				return view;
+			}
+
+			inline float GetNearPlane() const {
+				return nearPlane;
+			}
+
+			inline float GetFarPlane() const {
+				return farPlane;
+			}
+			// false when the frame's partition of the upload ring is full
+			bool SyncPerObject(const Fox::Vulkan::InstancedBatch& batch, uint32_t& dynamicOffset);
+			// the same data for pipelines that take it as push constants
+			static Fox::Vulkan::PerObjectConstantBuffer GetPerObjectData(const Fox::Vulkan::InstancedBatch& batch);
 
 		private:
 
-			void DeleteBuffers();
+			// reports the on-screen size of every textured model to the texture streaming
+			void RequestTextureDetail(const glm::mat4& view, const glm::mat4& proj, float viewportHeight);
 
-			std::vector<Fox::Vulkan::Buffer<PerFrameConstantBuffer>*> perFrame;
-			std::vector<Fox::Vulkan::Buffer<PerObjectConstantBuffer>*> perObject;
+			std::vector<Fox::Vulkan::Buffer<PerFrameConstantBuffer>> perFrame;
+			glm::mat4 view = glm::mat4(1.0f);
+			float nearPlane = 0.1f;
+			float farPlane = 10.0f;
 
 
 		};
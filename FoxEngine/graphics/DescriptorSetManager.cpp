@@ -12,29 +12,58 @@ namespace Fox {
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
             vkDestroyDescriptorPool(device, descriptorPool, nullptr);
             vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
-        
+
+            if (IsBindless()) {
+                vkDestroyDescriptorPool(device, bindlessDescriptorPool, nullptr);
+                vkDestroyDescriptorSetLayout(device, bindlessDescriptorSetLayout, nullptr);
+            }
         }
 	
 		void DescriptorSetManager::CreateDescriptorPools() {
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            uint32_t maxSets = numFramesInFlight * Fox::Vulkan::Renderer::GetRenderer()->GetConfig().maxTextures;
 
-            std::array<VkDescriptorPoolSize, 3> poolSizes{};
+            std::array<VkDescriptorPoolSize, 4> poolSizes{};
             poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            poolSizes[0].descriptorCount = static_cast<uint32_t>(numFramesInFlight);
-            poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            poolSizes[1].descriptorCount = static_cast<uint32_t>(numFramesInFlight);
+            poolSizes[0].descriptorCount = maxSets;
+            poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            poolSizes[1].descriptorCount = maxSets;
             poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            poolSizes[2].descriptorCount = static_cast<uint32_t>(numFramesInFlight);
+            poolSizes[2].descriptorCount = maxSets;
+            poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            poolSizes[3].descriptorCount = 2u * maxSets;
 
             VkDescriptorPoolCreateInfo poolInfo{};
             poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
             poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
             poolInfo.pPoolSizes = poolSizes.data();
-            poolInfo.maxSets = static_cast<uint32_t>(numFramesInFlight);
+            poolInfo.maxSets = maxSets;
 
             if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create descriptor pool!");
             }
+
+            if (!IsBindless()) {
+                return;
+            }
+
+            std::array<VkDescriptorPoolSize, 2> bindlessPoolSizes{};
+            bindlessPoolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bindlessPoolSizes[0].descriptorCount = textureTable.capacity;
+            bindlessPoolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindlessPoolSizes[1].descriptorCount = bufferTable.capacity;
+
+            VkDescriptorPoolCreateInfo bindlessPoolInfo{};
+            bindlessPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            bindlessPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+            bindlessPoolInfo.poolSizeCount = static_cast<uint32_t>(bindlessPoolSizes.size());
+            bindlessPoolInfo.pPoolSizes = bindlessPoolSizes.data();
+            bindlessPoolInfo.maxSets = 1;
+
+            if (vkCreateDescriptorPool(device, &bindlessPoolInfo, nullptr, &bindlessDescriptorPool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create bindless descriptor pool!");
+            }
 		}
 
         void DescriptorSetManager::CreateDescriptorSetLayouts() {
@@ -49,7 +78,7 @@ namespace Fox {
 
             VkDescriptorSetLayoutBinding ubo2LayoutBinding{};
             ubo2LayoutBinding.binding = 1;
-            ubo2LayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            ubo2LayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             ubo2LayoutBinding.descriptorCount = 1;
             ubo2LayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
             ubo2LayoutBinding.pImmutableSamplers = nullptr; // Optional
@@ -61,7 +90,23 @@ namespace Fox {
             samplerLayoutBinding.pImmutableSamplers = nullptr;
             samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
-            std::array<VkDescriptorSetLayoutBinding, 3> bindings = { uboLayoutBinding, ubo2LayoutBinding, samplerLayoutBinding };
+            // instance transforms of the frame, indexed with gl_InstanceIndex
+            VkDescriptorSetLayoutBinding instanceLayoutBinding{};
+            instanceLayoutBinding.binding = 3;
+            instanceLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            instanceLayoutBinding.descriptorCount = 1;
+            instanceLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+            instanceLayoutBinding.pImmutableSamplers = nullptr;
+
+            // per-draw data of the frame, indexed with the draw index of the instance
+            VkDescriptorSetLayoutBinding drawDataLayoutBinding{};
+            drawDataLayoutBinding.binding = 4;
+            drawDataLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            drawDataLayoutBinding.descriptorCount = 1;
+            drawDataLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+            drawDataLayoutBinding.pImmutableSamplers = nullptr;
+
+            std::array<VkDescriptorSetLayoutBinding, 5> bindings = { uboLayoutBinding, ubo2LayoutBinding, samplerLayoutBinding, instanceLayoutBinding, drawDataLayoutBinding };
             VkDescriptorSetLayoutCreateInfo layoutInfo{};
             layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
             layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
@@ -70,12 +115,213 @@ namespace Fox {
             if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create descriptor set layout!");
             }
+
+            if (Fox::Vulkan::Renderer::GetRenderer()->SupportsBindless()) {
+                CreateBindlessDescriptorSetLayout();
+            }
+        }
+
+        void DescriptorSetManager::CreateBindlessDescriptorSetLayout() {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            const Fox::Vulkan::RendererConfig& config = renderer->GetConfig();
+
+            VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties{};
+            indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+            VkPhysicalDeviceProperties2 properties{};
+            properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties.pNext = &indexingProperties;
+            vkGetPhysicalDeviceProperties2(renderer->physicalDevice, &properties);
+
+            textureTable.capacity = std::min({ config.maxBindlessTextures, indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages });
+            bufferTable.capacity = std::min({ config.maxBindlessBuffers, indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+                indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers });
+
+            VkDescriptorSetLayoutBinding textureBinding{};
+            textureBinding.binding = 0;
+            textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            textureBinding.descriptorCount = textureTable.capacity;
+            textureBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+            textureBinding.pImmutableSamplers = nullptr;
+
+            VkDescriptorSetLayoutBinding bufferBinding{};
+            bufferBinding.binding = 1;
+            bufferBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bufferBinding.descriptorCount = bufferTable.capacity;
+            bufferBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+            bufferBinding.pImmutableSamplers = nullptr;
+
+            // slots nobody registered are never written, slots of frames in flight are never rewritten
+            VkDescriptorBindingFlagsEXT bindingFlag = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+            std::array<VkDescriptorBindingFlagsEXT, 2> bindingFlags = { bindingFlag, bindingFlag };
+
+            VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo{};
+            bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+            bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+            bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+            std::array<VkDescriptorSetLayoutBinding, 2> bindings = { textureBinding, bufferBinding };
+            VkDescriptorSetLayoutCreateInfo layoutInfo{};
+            layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            layoutInfo.pNext = &bindingFlagsInfo;
+            layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+            layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+            layoutInfo.pBindings = bindings.data();
+
+            if (vkCreateDescriptorSetLayout(renderer->GetDevice(), &layoutInfo, nullptr, &bindlessDescriptorSetLayout) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create bindless descriptor set layout!");
+            }
         }
 
         void DescriptorSetManager::CreateDescriptorSets() {
-            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            Fox::Vulkan::Texture* defaultTexture = Fox::Vulkan::Renderer::GetRenderer()->GetTextureManager()->GetDefaultTexture();
+            AllocateDescriptorSets(defaultTexture);
+
+            if (!IsBindless()) {
+                return;
+            }
+
+            VkDescriptorSetAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.descriptorPool = bindlessDescriptorPool;
+            allocInfo.descriptorSetCount = 1;
+            allocInfo.pSetLayouts = &bindlessDescriptorSetLayout;
+
+            if (vkAllocateDescriptorSets(Fox::Vulkan::Renderer::GetDevice(), &allocInfo, &bindlessDescriptorSet) != VK_SUCCESS) {
+                throw std::runtime_error("failed to allocate bindless descriptor set!");
+            }
+
+            // slot 0 is the default texture, handed out when the table is full
+            GetTextureIndex(defaultTexture);
+        }
+
+        uint32_t DescriptorSetManager::GetTextureIndex(Fox::Vulkan::Texture* texture) {
+            uint64_t frameNumber = Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber();
+
+            auto it = bindlessTextures.find(texture);
+            if (it != bindlessTextures.end() && it->second.version == texture->GetVersion()) {
+                return it->second.index;
+            }
+
+            uint32_t index;
+            if (!textureTable.Allocate(frameNumber, numFramesInFlight, index)) {
+                std::cout << "Warning: bindless texture table is full, drawing with the default texture." << std::endl;
+                return 0u;
+            }
+
+            if (it != bindlessTextures.end()) {
+                textureTable.Release(frameNumber, it->second.index);
+            }
+
+            WriteBindlessTexture(index, texture);
+            bindlessTextures[texture] = { index, texture->GetVersion() };
+            return index;
+        }
+
+        uint32_t DescriptorSetManager::RegisterBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+            uint32_t index;
+            if (!bufferTable.Allocate(Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber(), numFramesInFlight, index)) {
+                throw std::runtime_error("Bindless buffer table is full!");
+            }
+
+            VkDescriptorBufferInfo bufferInfo{};
+            bufferInfo.buffer = buffer;
+            bufferInfo.offset = offset;
+            bufferInfo.range = range;
+
+            VkWriteDescriptorSet descriptorWrite{};
+            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrite.dstSet = bindlessDescriptorSet;
+            descriptorWrite.dstBinding = 1;
+            descriptorWrite.dstArrayElement = index;
+            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrite.descriptorCount = 1;
+            descriptorWrite.pBufferInfo = &bufferInfo;
+
+            vkUpdateDescriptorSets(Fox::Vulkan::Renderer::GetDevice(), 1, &descriptorWrite, 0, nullptr);
+            return index;
+        }
+
+        void DescriptorSetManager::ReleaseBuffer(uint32_t index) {
+            bufferTable.Release(Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber(), index);
+        }
+
+        void DescriptorSetManager::WriteBindlessTexture(uint32_t index, Fox::Vulkan::Texture* texture) {
             Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
 
+            VkDescriptorImageInfo imageInfo{};
+            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            imageInfo.imageView = texture->GetImageView();
+            imageInfo.sampler = renderer->GetSamplerManager()->GetSampler(renderer->GetGraphicsPipelineStateManager()->GetCurrentSamplerDescription());
+
+            VkWriteDescriptorSet descriptorWrite{};
+            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrite.dstSet = bindlessDescriptorSet;
+            descriptorWrite.dstBinding = 0;
+            descriptorWrite.dstArrayElement = index;
+            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            descriptorWrite.descriptorCount = 1;
+            descriptorWrite.pImageInfo = &imageInfo;
+
+            vkUpdateDescriptorSets(renderer->GetDevice(), 1, &descriptorWrite, 0, nullptr);
+        }
+
+        bool DescriptorSetManager::BindlessTable::Allocate(uint64_t frameNumber, uint32_t framesInFlight, uint32_t& slot) {
+            while (!retiredSlots.empty() && frameNumber >= retiredSlots.front().first + framesInFlight) {
+                freeSlots.push_back(retiredSlots.front().second);
+                retiredSlots.pop_front();
+            }
+
+            if (!freeSlots.empty()) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                return true;
+            }
+
+            if (used == capacity) {
+                return false;
+            }
+
+            slot = used++;
+            return true;
+        }
+
+        void DescriptorSetManager::BindlessTable::Release(uint64_t frameNumber, uint32_t slot) {
+            retiredSlots.emplace_back(frameNumber, slot);
+        }
+
+        VkDescriptorSet* DescriptorSetManager::GetAddressOfDescriptorSet(uint32_t imageIndex, Fox::Vulkan::Texture* texture) {
+            auto it = descriptorSets.find(texture);
+            TextureDescriptorSets& textureSets = it != descriptorSets.end() ? it->second : AllocateDescriptorSets(texture);
+
+            if (textureSets.versions[imageIndex] != texture->GetVersion()) {
+                WriteDescriptorSet(textureSets.sets[imageIndex], imageIndex, texture);
+                textureSets.versions[imageIndex] = texture->GetVersion();
+            }
+
+            return &textureSets.sets[imageIndex];
+        }
+
+        void DescriptorSetManager::ReleaseDescriptorSets(Fox::Vulkan::Texture* texture) {
+            auto bindless = bindlessTextures.find(texture);
+            if (bindless != bindlessTextures.end()) {
+                textureTable.Release(Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber(), bindless->second.index);
+                bindlessTextures.erase(bindless);
+            }
+
+            auto it = descriptorSets.find(texture);
+            if (it == descriptorSets.end()) {
+                return;
+            }
+
+            vkFreeDescriptorSets(Fox::Vulkan::Renderer::GetDevice(), descriptorPool, static_cast<uint32_t>(it->second.sets.size()), it->second.sets.data());
+            descriptorSets.erase(it);
+        }
+
+        DescriptorSetManager::TextureDescriptorSets& DescriptorSetManager::AllocateDescriptorSets(Fox::Vulkan::Texture* texture) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+
             std::vector<VkDescriptorSetLayout> layouts(numFramesInFlight, descriptorSetLayout);
             VkDescriptorSetAllocateInfo allocInfo{};
             allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -83,54 +329,89 @@ namespace Fox {
             allocInfo.descriptorSetCount = static_cast<uint32_t>(numFramesInFlight);
             allocInfo.pSetLayouts = layouts.data();
 
-            descriptorSets.resize(numFramesInFlight);
-            if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
+            TextureDescriptorSets& textureSets = descriptorSets[texture];
+            textureSets.sets.resize(numFramesInFlight);
+            if (vkAllocateDescriptorSets(device, &allocInfo, textureSets.sets.data()) != VK_SUCCESS) {
+                descriptorSets.erase(texture);
                 throw std::runtime_error("failed to allocate descriptor sets!");
             }
 
+            textureSets.versions.resize(numFramesInFlight);
             for (uint32_t i = 0; i < numFramesInFlight; i++) {
-                std::array<VkDescriptorBufferInfo, 1> bufferInfos{};
-                bufferInfos[0].buffer = renderer->GetConstantBuffers()->GetPerFrameConstantBuffer(i);
-                bufferInfos[0].offset = 0;
-                bufferInfos[0].range = sizeof(Fox::Vulkan::PerFrameConstantBuffer);
-                
-                std::array<VkDescriptorBufferInfo, 1> bufferInfos2{};
-                bufferInfos2[0].buffer = renderer->GetConstantBuffers()->GetPerObjectConstantBuffer(i);
-                bufferInfos2[0].offset = 0;
-                bufferInfos2[0].range = sizeof(Fox::Vulkan::PerObjectConstantBuffer);
-
-                VkDescriptorImageInfo imageInfo{};
-                imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                imageInfo.imageView = renderer->GetTextureManager()->GetImageViewForTexture();
-                imageInfo.sampler = renderer->GetSamplerManager()->GetSampler();
-
-                std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
-                descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrites[0].dstSet = descriptorSets[i];
-                descriptorWrites[0].dstBinding = 0;
-                descriptorWrites[0].dstArrayElement = 0;
-                descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-                descriptorWrites[0].descriptorCount = 1;
-                descriptorWrites[0].pBufferInfo = bufferInfos.data();
-
-                descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrites[1].dstSet = descriptorSets[i];
-                descriptorWrites[1].dstBinding = 1;
-                descriptorWrites[1].dstArrayElement = 0;
-                descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-                descriptorWrites[1].descriptorCount = 1;
-                descriptorWrites[1].pBufferInfo = bufferInfos2.data();
-
-                descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrites[2].dstSet = descriptorSets[i];
-                descriptorWrites[2].dstBinding = 2;
-                descriptorWrites[2].dstArrayElement = 0;
-                descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                descriptorWrites[2].descriptorCount = 1;
-                descriptorWrites[2].pImageInfo = &imageInfo;
-
-                vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+                WriteDescriptorSet(textureSets.sets[i], i, texture);
+                textureSets.versions[i] = texture->GetVersion();
             }
+
+            return textureSets;
+        }
+
+        void DescriptorSetManager::WriteDescriptorSet(VkDescriptorSet descriptorSet, uint32_t imageIndex, Fox::Vulkan::Texture* texture) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            std::array<VkDescriptorBufferInfo, 1> bufferInfos{};
+            bufferInfos[0].buffer = renderer->GetConstantBuffers()->GetPerFrameConstantBuffer(imageIndex);
+            bufferInfos[0].offset = 0;
+            bufferInfos[0].range = sizeof(Fox::Vulkan::PerFrameConstantBuffer);
+            
+            std::array<VkDescriptorBufferInfo, 1> bufferInfos2{};
+            bufferInfos2[0].buffer = renderer->GetConstantBuffers()->GetPerObjectConstantBuffer();
+            bufferInfos2[0].offset = 0;
+            bufferInfos2[0].range = sizeof(Fox::Vulkan::PerObjectConstantBuffer);
+
+            // the dynamic offset picks the frame's partition of the upload ring, instances and draw data are indexed inside it
+            std::array<VkDescriptorBufferInfo, 1> bufferInfos3{};
+            bufferInfos3[0].buffer = renderer->GetUploadRing()->GetBuffer();
+            bufferInfos3[0].offset = 0;
+            bufferInfos3[0].range = renderer->GetUploadRing()->GetPartitionSize();
+
+            VkDescriptorImageInfo imageInfo{};
+            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            imageInfo.imageView = texture->GetImageView();
+            imageInfo.sampler = renderer->GetSamplerManager()->GetSampler(renderer->GetGraphicsPipelineStateManager()->GetCurrentSamplerDescription());
+
+            std::array<VkWriteDescriptorSet, 5> descriptorWrites{};
+            descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[0].dstSet = descriptorSet;
+            descriptorWrites[0].dstBinding = 0;
+            descriptorWrites[0].dstArrayElement = 0;
+            descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            descriptorWrites[0].descriptorCount = 1;
+            descriptorWrites[0].pBufferInfo = bufferInfos.data();
+
+            descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[1].dstSet = descriptorSet;
+            descriptorWrites[1].dstBinding = 1;
+            descriptorWrites[1].dstArrayElement = 0;
+            descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            descriptorWrites[1].descriptorCount = 1;
+            descriptorWrites[1].pBufferInfo = bufferInfos2.data();
+
+            descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[2].dstSet = descriptorSet;
+            descriptorWrites[2].dstBinding = 2;
+            descriptorWrites[2].dstArrayElement = 0;
+            descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            descriptorWrites[2].descriptorCount = 1;
+            descriptorWrites[2].pImageInfo = &imageInfo;
+
+            descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[3].dstSet = descriptorSet;
+            descriptorWrites[3].dstBinding = 3;
+            descriptorWrites[3].dstArrayElement = 0;
+            descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            descriptorWrites[3].descriptorCount = 1;
+            descriptorWrites[3].pBufferInfo = bufferInfos3.data();
+
+            descriptorWrites[4].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[4].dstSet = descriptorSet;
+            descriptorWrites[4].dstBinding = 4;
+            descriptorWrites[4].dstArrayElement = 0;
+            descriptorWrites[4].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            descriptorWrites[4].descriptorCount = 1;
+            descriptorWrites[4].pBufferInfo = bufferInfos3.data();
+
+            vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
         }
 
 	}
@@ -13,21 +13,73 @@ namespace Fox {
 			void CreateDescriptorSetLayouts();
 			void CreateDescriptorSets();
 
-			VkDescriptorSet* GetAddressOfDescriptorSet(uint32_t imageIndex) {
-				return &descriptorSets[imageIndex];
-			}
+			// per-frame sets are created the first time a texture is drawn and freed when the texture is destroyed,
+			// a set is rewritten when the texture was resized since, which is safe as the frame's previous use has completed
+			VkDescriptorSet* GetAddressOfDescriptorSet(uint32_t imageIndex, Fox::Vulkan::Texture* texture);
+			void ReleaseDescriptorSets(Fox::Vulkan::Texture* texture);
 
 			VkDescriptorSetLayout* GetAddressOfDescriptorSetLayout() {
 				return &descriptorSetLayout;
 			}
 
+			// Bindless tables in set 1, created when the device supports descriptor indexing. Textures and storage buffers
+			// get a stable slot in one large partially bound array that is updated after bind, shaders index it with the
+			// slot found in the per-object data. A texture resized by streaming moves to a new slot as the old one may still
+			// be read by a frame in flight, released slots are reused once those frames have completed.
+			inline bool IsBindless() const {
+				return bindlessDescriptorSetLayout != VK_NULL_HANDLE;
+			}
+
+			uint32_t GetTextureIndex(Fox::Vulkan::Texture* texture);
+			uint32_t RegisterBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+			void ReleaseBuffer(uint32_t index);
+
+			VkDescriptorSet* GetAddressOfBindlessDescriptorSet() {
+				return &bindlessDescriptorSet;
+			}
+
+			VkDescriptorSetLayout* GetAddressOfBindlessDescriptorSetLayout() {
+				return &bindlessDescriptorSetLayout;
+			}
+
 		private: 
 			uint32_t numFramesInFlight;
 			VkDescriptorPool descriptorPool;
 			VkDescriptorSetLayout descriptorSetLayout;
-			std::vector<VkDescriptorSet> descriptorSets;
+			struct TextureDescriptorSets {
+				std::vector<VkDescriptorSet> sets;
+				std::vector<uint64_t> versions;
+			};
+
+			std::unordered_map<Fox::Vulkan::Texture*, TextureDescriptorSets> descriptorSets;
+
+			TextureDescriptorSets& AllocateDescriptorSets(Fox::Vulkan::Texture* texture);
+			void WriteDescriptorSet(VkDescriptorSet descriptorSet, uint32_t imageIndex, Fox::Vulkan::Texture* texture);
+
+			struct BindlessTable {
+				uint32_t capacity = 0u;
+				uint32_t used = 0u;
+				std::vector<uint32_t> freeSlots;
+				std::deque<std::pair<uint64_t, uint32_t>> retiredSlots;	// frame released, slot
+
+				bool Allocate(uint64_t frameNumber, uint32_t framesInFlight, uint32_t& slot);
+				void Release(uint64_t frameNumber, uint32_t slot);
+			};
+
+			struct BindlessTexture {
+				uint32_t index;
+				uint64_t version;
+			};
+
+			void CreateBindlessDescriptorSetLayout();
+			void WriteBindlessTexture(uint32_t index, Fox::Vulkan::Texture* texture);
 
-			
+			VkDescriptorPool bindlessDescriptorPool = VK_NULL_HANDLE;
+			VkDescriptorSetLayout bindlessDescriptorSetLayout = VK_NULL_HANDLE;
+			VkDescriptorSet bindlessDescriptorSet = VK_NULL_HANDLE;
+			BindlessTable textureTable;
+			BindlessTable bufferTable;
+			std::unordered_map<Fox::Vulkan::Texture*, BindlessTexture> bindlessTextures;
 		};
 
 	}
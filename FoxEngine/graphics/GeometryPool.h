@@ -0,0 +1,182 @@
+#pragma once
+
+#include "graphics/Renderer.h"
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		struct GeometryAllocation {
+			uint32_t vertexOffset = 0u;
+			uint32_t vertexCount = 0u;
+			uint32_t firstIndex = 0u;
+			uint32_t indexCount = 0u;
+
+			Fox::Core::TlsfAllocator::Allocation vertexAllocation;
+			Fox::Core::TlsfAllocator::Allocation indexAllocation;
+
+			bool IsValid() const {
+				return vertexAllocation.IsValid() && indexAllocation.IsValid();
+			}
+		};
+
+		struct GeometryPoolStatistics {
+			Fox::Core::AllocatorStatistics vertices;
+			Fox::Core::AllocatorStatistics indices;
+		};
+
+		// Engine-wide device local vertex and index buffers. Meshes sub-allocate ranges in element units so
+		// that every draw can share a single vertex/index buffer bind and address its geometry with firstIndex/vertexOffset.
+		template<class V, class I>
+		class GeometryPool {
+		public:
+			GeometryPool() = default;
+			GeometryPool(uint32_t maxVertices, uint32_t maxIndices, uint32_t numFramesInFlight);
+			~GeometryPool();
+
+			bool Allocate(uint32_t vertexCount, uint32_t indexCount, Fox::Vulkan::GeometryAllocation& allocation);
+			// for ranges no command buffer has read yet
+			void Free(Fox::Vulkan::GeometryAllocation& allocation);
+			// keeps the range until the frames in flight that may still draw it have finished
+			void Release(Fox::Vulkan::GeometryAllocation& allocation);
+			// frees released ranges whose frames are done, once per frame after waiting for the frame's fence
+			void CollectGarbage(uint64_t frameNumber);
+			void Upload(const Fox::Vulkan::GeometryAllocation& allocation, const std::vector<V>& vertices, const std::vector<I>& indices);
+
+			Fox::Vulkan::GeometryPoolStatistics GetStatistics() const;
+			void PrintStatistics() const;
+
+			inline VkBuffer GetVertexBuffer() {
+				return vertexBuffer->GetBuffer();
+			}
+
+			inline VkBuffer GetIndexBuffer() {
+				return indexBuffer->GetBuffer();
+			}
+
+			static constexpr VkIndexType GetIndexType() {
+				return sizeof(I) == sizeof(uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+			}
+
+		private:
+			std::unique_ptr<Fox::Vulkan::Buffer<V>> vertexBuffer;
+			std::unique_ptr<Fox::Vulkan::Buffer<I>> indexBuffer;
+
+			Fox::Core::TlsfAllocator vertexAllocator;
+			Fox::Core::TlsfAllocator indexAllocator;
+
+			uint32_t numFramesInFlight = 0u;
+			std::vector<std::pair<uint64_t, Fox::Vulkan::GeometryAllocation>> releasedAllocations;
+		};
+
+		template<class V, class I>
+		GeometryPool<V, I>::GeometryPool(uint32_t maxVertices, uint32_t maxIndices, uint32_t numFramesInFlight) : numFramesInFlight(numFramesInFlight) {
+			// dedicated memory, a sub-allocated pool buffer would pin its block and keep defragmentation from ever evacuating it
+			vertexBuffer = std::make_unique<Fox::Vulkan::Buffer<V>>();
+			vertexBuffer->Create(sizeof(V) * static_cast<VkDeviceSize>(maxVertices), VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+
+			indexBuffer = std::make_unique<Fox::Vulkan::Buffer<I>>();
+			indexBuffer->Create(sizeof(I) * static_cast<VkDeviceSize>(maxIndices), VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+
+			vertexAllocator.Initialize(maxVertices);
+			indexAllocator.Initialize(maxIndices);
+		}
+
+		template<class V, class I>
+		GeometryPool<V, I>::~GeometryPool() {
+			// the device is idle by now
+			for (auto& released : releasedAllocations) {
+				Free(released.second);
+			}
+			releasedAllocations.clear();
+
+			if (!vertexAllocator.IsEmpty() || !indexAllocator.IsEmpty()) {
+				std::cout << "Warning: geometry pool destroyed with live mesh allocations." << std::endl;
+			}
+		}
+
+		template<class V, class I>
+		bool GeometryPool<V, I>::Allocate(uint32_t vertexCount, uint32_t indexCount, Fox::Vulkan::GeometryAllocation& allocation) {
+			if (!vertexAllocator.Allocate(vertexCount, 1u, allocation.vertexAllocation)) {
+				return false;
+			}
+
+			if (!indexAllocator.Allocate(indexCount, 1u, allocation.indexAllocation)) {
+				vertexAllocator.Free(allocation.vertexAllocation);
+				return false;
+			}
+
+			allocation.vertexOffset = static_cast<uint32_t>(allocation.vertexAllocation.offset);
+			allocation.vertexCount = vertexCount;
+			allocation.firstIndex = static_cast<uint32_t>(allocation.indexAllocation.offset);
+			allocation.indexCount = indexCount;
+
+			return true;
+		}
+
+		template<class V, class I>
+		void GeometryPool<V, I>::Free(Fox::Vulkan::GeometryAllocation& allocation) {
+			vertexAllocator.Free(allocation.vertexAllocation);
+			indexAllocator.Free(allocation.indexAllocation);
+			allocation = Fox::Vulkan::GeometryAllocation();
+		}
+
+		template<class V, class I>
+		void GeometryPool<V, I>::Release(Fox::Vulkan::GeometryAllocation& allocation) {
+			releasedAllocations.push_back({ Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber(), allocation });
+			allocation = Fox::Vulkan::GeometryAllocation();
+		}
+
+		template<class V, class I>
+		void GeometryPool<V, I>::CollectGarbage(uint64_t frameNumber) {
+			for (auto it = releasedAllocations.begin(); it != releasedAllocations.end();) {
+				if (frameNumber >= it->first + numFramesInFlight) {
+					Free(it->second);
+					it = releasedAllocations.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		template<class V, class I>
+		void GeometryPool<V, I>::Upload(const Fox::Vulkan::GeometryAllocation& allocation, const std::vector<V>& vertices, const std::vector<I>& indices) {
+			Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+			Fox::Vulkan::StagingPool* stagingPool = renderer->GetStagingPool();
+
+			// CopyBuffer waits for the queue, the regions can be freed right after
+			VkDeviceSize vertexBufferSize = sizeof(V) * vertices.size();
+			Fox::Vulkan::StagingAllocation vertexStaging = stagingPool->Allocate(vertexBufferSize);
+			memcpy(vertexStaging.data, vertices.data(), vertexBufferSize);
+			renderer->CopyBuffer(vertexStaging.buffer, vertexBuffer->GetBuffer(), vertexBufferSize, vertexStaging.offset, sizeof(V) * static_cast<VkDeviceSize>(allocation.vertexOffset));
+			stagingPool->Free(vertexStaging);
+
+			VkDeviceSize indexBufferSize = sizeof(I) * indices.size();
+			Fox::Vulkan::StagingAllocation indexStaging = stagingPool->Allocate(indexBufferSize);
+			memcpy(indexStaging.data, indices.data(), indexBufferSize);
+			renderer->CopyBuffer(indexStaging.buffer, indexBuffer->GetBuffer(), indexBufferSize, indexStaging.offset, sizeof(I) * static_cast<VkDeviceSize>(allocation.firstIndex));
+			stagingPool->Free(indexStaging);
+		}
+
+		template<class V, class I>
+		Fox::Vulkan::GeometryPoolStatistics GeometryPool<V, I>::GetStatistics() const {
+			Fox::Vulkan::GeometryPoolStatistics statistics;
+			statistics.vertices = vertexAllocator.GetStatistics();
+			statistics.indices = indexAllocator.GetStatistics();
+			return statistics;
+		}
+
+		template<class V, class I>
+		void GeometryPool<V, I>::PrintStatistics() const {
+			Fox::Vulkan::GeometryPoolStatistics statistics = GetStatistics();
+			std::cout << "Geometry pool vertices: " << statistics.vertices.usedBytes << "/" << statistics.vertices.capacity
+				<< " (occupancy " << statistics.vertices.GetOccupancy() * 100.0f << "%, fragmentation " << statistics.vertices.GetFragmentation() * 100.0f
+				<< "%, " << statistics.vertices.allocationCount << " meshes, " << statistics.vertices.freeBlockCount << " free ranges)" << std::endl;
+			std::cout << "Geometry pool indices: " << statistics.indices.usedBytes << "/" << statistics.indices.capacity
+				<< " (occupancy " << statistics.indices.GetOccupancy() * 100.0f << "%, fragmentation " << statistics.indices.GetFragmentation() * 100.0f
+				<< "%, " << statistics.indices.allocationCount << " meshes, " << statistics.indices.freeBlockCount << " free ranges)" << std::endl;
+		}
+	}
+}
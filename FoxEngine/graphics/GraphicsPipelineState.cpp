@@ -1,5 +1,7 @@
 #include "pch.h"
 
+#include <filesystem>
+
 namespace Fox {
 
 	namespace Vulkan {
@@ -15,12 +17,29 @@ namespace Fox {
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
             Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
 
+            std::vector<VkDescriptorSetLayout> setLayouts = { *renderer->GetDesciptorManager()->GetAddressOfDescriptorSetLayout() };
+            if (config.bindless) {
+                setLayouts.push_back(*renderer->GetDesciptorManager()->GetAddressOfBindlessDescriptorSetLayout());
+            }
+
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(renderer->physicalDevice, &properties);
+
+            std::vector<VkPushConstantRange> pushConstantRanges;
+            for (const Fox::Vulkan::PushConstantConfig& pushConstant : config.pushConstants) {
+                if (pushConstant.offset + pushConstant.size > properties.limits.maxPushConstantsSize) {
+                    throw std::runtime_error("Push constants of pipeline " + name + " exceed the device limit of " +
+                        std::to_string(properties.limits.maxPushConstantsSize) + " bytes!");
+                }
+                pushConstantRanges.push_back({ pushConstant.stages, pushConstant.offset, pushConstant.size });
+            }
+
             VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
             pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-            pipelineLayoutInfo.setLayoutCount = 1; // Optional
-            pipelineLayoutInfo.pSetLayouts = renderer->GetDesciptorManager()->GetAddressOfDescriptorSetLayout(); // Optional
-            pipelineLayoutInfo.pushConstantRangeCount = 0; // Optional
-            pipelineLayoutInfo.pPushConstantRanges = nullptr; // Optional
+            pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+            pipelineLayoutInfo.pSetLayouts = setLayouts.data();
+            pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+            pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.empty() ? nullptr : pushConstantRanges.data();
 
             if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create pipeline layout!");
@@ -295,6 +314,30 @@ namespace Fox {
 		GraphicsPipelineStateManager::~GraphicsPipelineStateManager() {
 		}
 
+        VkShaderStageFlags GraphicsPipelineStateManager::GetCurrentPushConstantStages(uint32_t offset, uint32_t size) {
+            // vkCmdPushConstants needs the stages of every range overlapping the update, and the update has to lie inside them
+            const std::vector<Fox::Vulkan::PushConstantConfig>& pushConstants = currentPipelineState->GetConfig().pushConstants;
+            uint32_t end = offset + size;
+
+            VkShaderStageFlags stages = 0u;
+            for (const Fox::Vulkan::PushConstantConfig& pushConstant : pushConstants) {
+                if (pushConstant.offset < end && offset < pushConstant.offset + pushConstant.size) {
+                    stages |= pushConstant.stages;
+                }
+            }
+
+            for (uint32_t position = offset; position < end;) {
+                auto range = std::find_if(pushConstants.begin(), pushConstants.end(), [position](const Fox::Vulkan::PushConstantConfig& pushConstant) {
+                    return pushConstant.offset <= position && position < pushConstant.offset + pushConstant.size;
+                });
+                if (range == pushConstants.end()) {
+                    return 0u;
+                }
+                position = range->offset + range->size;
+            }
+            return stages;
+        }
+
         std::vector<Fox::Vulkan::PipelineConfig> GraphicsPipelineStateManager::ReadPipelineConfigs(const std::string& path) {
             std::vector<Fox::Vulkan::PipelineConfig> pipelineConfigs;
             std::string data = Fox::Core::FileSystem::ReadFile(path);
@@ -332,6 +375,20 @@ namespace Fox {
 
             for (size_t i = 0u; i < pipelineConfigs.size(); i++) {
                 std::string name = pipelineConfigs[i].name;
+
+                if (pipelineConfigs[i].bindless && !renderer->GetDesciptorManager()->IsBindless()) {
+                    std::cout << "Warning: skipping pipeline " << name << ", it needs descriptor indexing." << std::endl;
+                    continue;
+                }
+
+                // the binaries are committed next to their sources, a listed pipeline without them is a broken checkout
+                auto missingShader = std::find_if(pipelineConfigs[i].shaders.begin(), pipelineConfigs[i].shaders.end(), [](const Fox::Vulkan::ShaderConfig& shader) {
+                    return !std::filesystem::exists(shader.path);
+                });
+                if (missingShader != pipelineConfigs[i].shaders.end()) {
+                    throw std::runtime_error("Shader " + missingShader->path + " of pipeline " + name + " was not found, rebuild it with shaders/compile.bat!");
+                }
+
                 pipelineStates[name] = std::make_shared<GraphicsPipelineState>();
                 Fox::Vulkan::GraphicsPipelineState* currentPipeline = pipelineStates[name].get();
                 currentPipeline->SetName(name);
@@ -449,7 +506,13 @@ namespace Fox {
                 }
             }
 
-            SetCurrentPipelineState("default");
+            // the bindless pipeline draws everything with one set of textures when it could be created, the indirect one
+            // additionally submits everything with a single draw where the device can source draws from a buffer
+            if (renderer->SupportsIndirectDraws() && pipelineStates.find("indirect") != pipelineStates.end()) {
+                SetCurrentPipelineState("indirect");
+            } else {
+                SetCurrentPipelineState(pipelineStates.find("bindless") != pipelineStates.end() ? "bindless" : "default");
+            }
 
         }
 	}
@@ -153,6 +153,21 @@ namespace Fox {
 				return currentPipelineState->GetConfig().lineWidth;
 			}
 
+			// stages to pass to vkCmdPushConstants for the byte range, 0 when the current pipeline has no range covering it
+			VkShaderStageFlags GetCurrentPushConstantStages(uint32_t offset, uint32_t size);
+
+			inline bool IsCurrentPipelineBindless() {
+				return currentPipelineState->GetConfig().bindless;
+			}
+
+			inline bool IsCurrentPipelineIndirect() {
+				return currentPipelineState->GetConfig().indirect;
+			}
+
+			inline const Fox::Vulkan::SamplerDescription& GetCurrentSamplerDescription() {
+				return currentPipelineState->GetConfig().sampler;
+			}
+
 			bool RenderWideLines() {
 				return currentPipelineState->GetConfig().lineWidth != 1.0f && (currentPipelineState->GetConfig().topology == Fox::Vulkan::PrimitiveTopology::LINES ||
 					currentPipelineState->GetConfig().topology == Fox::Vulkan::PrimitiveTopology::LINE_STRIP);
@@ -0,0 +1,550 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		MemoryAllocator::MemoryAllocator(VkDeviceSize blockSize) : blockSize(blockSize) {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(renderer->physicalDevice, &properties);
+            maxAllocationCount = properties.limits.maxMemoryAllocationCount;
+
+            vkGetPhysicalDeviceMemoryProperties(renderer->physicalDevice, &memoryProperties);
+
+            memoryTypeUsage.resize(memoryProperties.memoryTypeCount);
+            heapUsage.resize(memoryProperties.memoryHeapCount);
+
+            pools.resize(memoryProperties.memoryTypeCount * 2u);
+            for (uint32_t memoryType = 0u; memoryType < memoryProperties.memoryTypeCount; memoryType++) {
+                // small heaps such as the host visible device local one would be used up by a few blocks
+                VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[memoryType].heapIndex].size;
+                VkDeviceSize poolBlockSize = std::max<VkDeviceSize>(std::min(blockSize, heapSize / 8u), 1u << 20u);
+
+                for (uint32_t kind = 0u; kind < 2u; kind++) {
+                    pools[memoryType * 2u + kind].memoryType = memoryType;
+                    pools[memoryType * 2u + kind].blockSize = poolBlockSize;
+                }
+            }
+		}
+
+		MemoryAllocator::~MemoryAllocator() {
+            for (Pool& pool : pools) {
+                for (std::unique_ptr<Block>& block : pool.blocks) {
+                    if (!block) {
+                        continue;
+                    }
+
+                    if (!block->allocator.IsEmpty()) {
+                        std::cout << "Warning: " << block->allocator.GetStatistics().allocationCount << " allocations still alive in memory type "
+                            << pool.memoryType << "." << std::endl;
+                    }
+                    ReleaseMemory(pool.memoryType, block->memory, pool.blockSize);
+                }
+                pool.blocks.clear();
+            }
+		}
+
+        Fox::Vulkan::MemoryAllocation MemoryAllocator::AllocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties, Fox::Vulkan::MemoryCategory category, bool dedicated) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+
+            VkMemoryRequirements memRequirements;
+
+            if (Fox::Vulkan::Renderer::GetRenderer()->GetApiVersion() >= VK_API_VERSION_1_1) {
+                VkMemoryDedicatedRequirements dedicatedRequirements{};
+                dedicatedRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+                VkMemoryRequirements2 requirements{};
+                requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+                requirements.pNext = &dedicatedRequirements;
+                VkBufferMemoryRequirementsInfo2 info{};
+                info.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+                info.buffer = buffer;
+                vkGetBufferMemoryRequirements2(device, &info, &requirements);
+
+                memRequirements = requirements.memoryRequirements;
+                dedicated = dedicated || dedicatedRequirements.requiresDedicatedAllocation || dedicatedRequirements.prefersDedicatedAllocation;
+            } else {
+                vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+            }
+
+            Fox::Vulkan::MemoryAllocation allocation = Allocate(memRequirements, properties, true, dedicated, buffer, VK_NULL_HANDLE, category);
+            vkBindBufferMemory(device, buffer, allocation.memory, allocation.offset);
+            return allocation;
+        }
+
+        Fox::Vulkan::MemoryAllocation MemoryAllocator::AllocateForImage(VkImage image, VkMemoryPropertyFlags properties, bool linear, bool dedicated,
+            Fox::Vulkan::MemoryCategory category) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+
+            VkMemoryRequirements memRequirements;
+
+            if (Fox::Vulkan::Renderer::GetRenderer()->GetApiVersion() >= VK_API_VERSION_1_1) {
+                VkMemoryDedicatedRequirements dedicatedRequirements{};
+                dedicatedRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+                VkMemoryRequirements2 requirements{};
+                requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+                requirements.pNext = &dedicatedRequirements;
+                VkImageMemoryRequirementsInfo2 info{};
+                info.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+                info.image = image;
+                vkGetImageMemoryRequirements2(device, &info, &requirements);
+
+                memRequirements = requirements.memoryRequirements;
+                dedicated = dedicated || dedicatedRequirements.requiresDedicatedAllocation || dedicatedRequirements.prefersDedicatedAllocation;
+            } else {
+                vkGetImageMemoryRequirements(device, image, &memRequirements);
+            }
+
+            Fox::Vulkan::MemoryAllocation allocation = Allocate(memRequirements, properties, linear, dedicated, VK_NULL_HANDLE, image, category);
+            vkBindImageMemory(device, image, allocation.memory, allocation.offset);
+            return allocation;
+        }
+
+        Fox::Vulkan::MemoryAllocation MemoryAllocator::Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear, bool dedicated,
+            VkBuffer buffer, VkImage image, Fox::Vulkan::MemoryCategory category) {
+            // lazily allocated memory is only a hint, most desktop devices have no such memory type
+            uint32_t memoryType = FindMemoryType(requirements.memoryTypeBits, properties);
+            if (memoryType == ~0u && (properties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)) {
+                memoryType = FindMemoryType(requirements.memoryTypeBits, properties & ~VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+            }
+            if (memoryType == ~0u) {
+                throw std::runtime_error("Failed to find suitable memory type!");
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            Pool& pool = pools[memoryType * 2u + (linear ? 0u : 1u)];
+            if (dedicated || requirements.size > pool.blockSize / 2u) {
+                Fox::Vulkan::MemoryAllocation allocation = AllocateDedicated(memoryType, requirements.size, buffer, image);
+                allocation.category = category;
+                totalUsage.Add(requirements.size);
+                categoryUsage[static_cast<size_t>(category)].Add(requirements.size);
+                return allocation;
+            }
+
+            Fox::Vulkan::MemoryAllocation allocation;
+            allocation.memoryType = memoryType;
+            allocation.category = category;
+            allocation.pool = static_cast<uint32_t>(&pool - pools.data());
+
+            for (uint32_t i = 0u; i < pool.blocks.size(); i++) {
+                Block* block = pool.blocks[i].get();
+                if (block && !block->evacuating && block->allocator.Allocate(requirements.size, requirements.alignment, allocation.range)) {
+                    allocation.block = i;
+                    break;
+                }
+            }
+
+            if (allocation.block == ~0u) {
+                std::unique_ptr<Block> block = std::make_unique<Block>();
+                block->memory = AllocateMemory(memoryType, pool.blockSize, VK_NULL_HANDLE, VK_NULL_HANDLE);
+                try {
+                    block->mappedMemory = MapMemory(memoryType, block->memory);
+                } catch (...) {
+                    ReleaseMemory(memoryType, block->memory, pool.blockSize);
+                    throw;
+                }
+                block->allocator.Initialize(pool.blockSize);
+                block->allocator.Allocate(requirements.size, requirements.alignment, allocation.range);
+
+                auto slot = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+                if (slot == pool.blocks.end()) {
+                    slot = pool.blocks.insert(pool.blocks.end(), nullptr);
+                }
+                *slot = std::move(block);
+                allocation.block = static_cast<uint32_t>(slot - pool.blocks.begin());
+            }
+
+            Block* block = pool.blocks[allocation.block].get();
+            allocation.memory = block->memory;
+            allocation.offset = allocation.range.offset;
+            allocation.size = requirements.size;
+            allocation.mappedMemory = block->mappedMemory ? static_cast<uint8_t*>(block->mappedMemory) + allocation.offset : nullptr;
+
+            // only accounted once the allocation can no longer fail
+            totalUsage.Add(requirements.size);
+            categoryUsage[static_cast<size_t>(category)].Add(requirements.size);
+            return allocation;
+        }
+
+        uint32_t MemoryAllocator::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+            for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+                if ((typeFilter & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                    return i;
+                }
+            }
+            return ~0u;
+        }
+
+        Fox::Vulkan::MemoryAllocation MemoryAllocator::AllocateDedicated(uint32_t memoryType, VkDeviceSize size, VkBuffer buffer, VkImage image) {
+            Fox::Vulkan::MemoryAllocation allocation;
+            allocation.memory = AllocateMemory(memoryType, size, buffer, image);
+            allocation.size = size;
+            allocation.memoryType = memoryType;
+            try {
+                allocation.mappedMemory = MapMemory(memoryType, allocation.memory);
+            } catch (...) {
+                ReleaseMemory(memoryType, allocation.memory, size);
+                throw;
+            }
+
+            dedicatedAllocations++;
+            dedicatedBytes += size;
+            return allocation;
+        }
+
+        void MemoryAllocator::Free(Fox::Vulkan::MemoryAllocation& allocation) {
+            if (!allocation.IsValid()) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            totalUsage.Remove(allocation.size);
+            categoryUsage[static_cast<size_t>(allocation.category)].Remove(allocation.size);
+
+            if (allocation.IsDedicated()) {
+                ReleaseMemory(allocation.memoryType, allocation.memory, allocation.size);
+                dedicatedAllocations--;
+                dedicatedBytes -= allocation.size;
+                allocation = Fox::Vulkan::MemoryAllocation();
+                return;
+            }
+
+            Pool& pool = pools[allocation.pool];
+            std::unique_ptr<Block>& block = pool.blocks[allocation.block];
+            block->allocator.Free(allocation.range);
+            block->pinned = false;
+
+            if (block->evacuating && block->allocator.IsEmpty()) {
+                ReleaseMemory(pool.memoryType, block->memory, pool.blockSize);
+                block = nullptr;
+                evacuatingPool = ~0u;
+                evacuatingBlock = ~0u;
+
+                defragmentationStatistics.releasedBlocks++;
+                defragmentationStatistics.reclaimedBytes += pool.blockSize;
+                std::cout << "Defragmentation released a block of " << pool.blockSize << " bytes, " << defragmentationStatistics.reclaimedBytes
+                    << " bytes reclaimed so far." << std::endl;
+
+                allocation = Fox::Vulkan::MemoryAllocation();
+                return;
+            }
+
+            // one empty block per pool is kept around so that a single resource coming and going does not allocate each time
+            if (block->allocator.IsEmpty()) {
+                uint32_t emptyBlocks = static_cast<uint32_t>(std::count_if(pool.blocks.begin(), pool.blocks.end(), [](const std::unique_ptr<Block>& other) {
+                    return other && other->allocator.IsEmpty();
+                }));
+                if (emptyBlocks > 1u) {
+                    ReleaseMemory(pool.memoryType, block->memory, pool.blockSize);
+                    block = nullptr;
+                }
+            }
+
+            allocation = Fox::Vulkan::MemoryAllocation();
+        }
+
+        bool MemoryAllocator::IsLazilyAllocated(const Fox::Vulkan::MemoryAllocation& allocation) const {
+            return allocation.IsValid() && (memoryProperties.memoryTypes[allocation.memoryType].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+        }
+
+        VkDeviceSize MemoryAllocator::GetCommittedBytes(const Fox::Vulkan::MemoryAllocation& allocation) {
+            if (!IsLazilyAllocated(allocation)) {
+                return allocation.size;
+            }
+
+            VkDeviceSize committed = 0u;
+            vkGetDeviceMemoryCommitment(Fox::Vulkan::Renderer::GetDevice(), allocation.memory, &committed);
+            return committed;
+        }
+
+        VkDeviceMemory MemoryAllocator::AllocateMemory(uint32_t memoryType, VkDeviceSize size, VkBuffer buffer, VkImage image) {
+            if (allocationCount >= maxAllocationCount) {
+                throw std::runtime_error("Exceeded maxMemoryAllocationCount!");
+            }
+
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = size;
+            allocInfo.memoryTypeIndex = memoryType;
+
+            VkMemoryDedicatedAllocateInfo dedicatedInfo{};
+            dedicatedInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+            dedicatedInfo.buffer = buffer;
+            dedicatedInfo.image = image;
+            if ((buffer != VK_NULL_HANDLE || image != VK_NULL_HANDLE) && Fox::Vulkan::Renderer::GetRenderer()->GetApiVersion() >= VK_API_VERSION_1_1) {
+                allocInfo.pNext = &dedicatedInfo;
+            }
+
+            VkDeviceMemory memory;
+            if (vkAllocateMemory(Fox::Vulkan::Renderer::GetDevice(), &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+                throw std::runtime_error("failed to allocate device memory!");
+            }
+
+            allocationCount++;
+            memoryTypeUsage[memoryType].Add(size);
+            heapUsage[memoryProperties.memoryTypes[memoryType].heapIndex].Add(size);
+            return memory;
+        }
+
+        void* MemoryAllocator::MapMemory(uint32_t memoryType, VkDeviceMemory memory) {
+            if ((memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) {
+                return nullptr;
+            }
+
+            void* mappedMemory;
+            if (vkMapMemory(Fox::Vulkan::Renderer::GetDevice(), memory, 0, VK_WHOLE_SIZE, 0, &mappedMemory) != VK_SUCCESS) {
+                throw std::runtime_error("failed to map device memory!");
+            }
+            return mappedMemory;
+        }
+
+        void MemoryAllocator::ReleaseMemory(uint32_t memoryType, VkDeviceMemory memory, VkDeviceSize size) {
+            // freeing memory unmaps it implicitly
+            vkFreeMemory(Fox::Vulkan::Renderer::GetDevice(), memory, nullptr);
+            allocationCount--;
+            memoryTypeUsage[memoryType].Remove(size);
+            heapUsage[memoryProperties.memoryTypes[memoryType].heapIndex].Remove(size);
+        }
+
+        Fox::Vulkan::MemoryAllocatorStatistics MemoryAllocator::GetStatistics() {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            Fox::Vulkan::MemoryAllocatorStatistics statistics;
+            statistics.dedicatedAllocations = dedicatedAllocations;
+            statistics.dedicatedBytes = dedicatedBytes;
+
+            for (const Pool& pool : pools) {
+                for (const std::unique_ptr<Block>& block : pool.blocks) {
+                    if (!block) {
+                        continue;
+                    }
+
+                    Fox::Core::AllocatorStatistics blockStatistics = block->allocator.GetStatistics();
+                    statistics.blocks++;
+                    statistics.blockBytes += blockStatistics.capacity;
+                    statistics.usedBytes += blockStatistics.usedBytes;
+                    statistics.allocations += blockStatistics.allocationCount;
+                }
+            }
+
+            return statistics;
+        }
+
+        bool MemoryAllocator::BeginEvacuation() {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (evacuatingPool != ~0u) {
+                return true;
+            }
+
+            for (uint32_t poolIndex = 0u; poolIndex < pools.size(); poolIndex++) {
+                Pool& pool = pools[poolIndex];
+                if ((memoryProperties.memoryTypes[pool.memoryType].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == 0) {
+                    continue;
+                }
+
+                uint64_t freeBytes = 0u;
+                uint32_t source = ~0u;
+                uint64_t sourceBytes = ~0ull;
+
+                for (uint32_t i = 0u; i < pool.blocks.size(); i++) {
+                    Block* block = pool.blocks[i].get();
+                    if (!block) {
+                        continue;
+                    }
+
+                    Fox::Core::AllocatorStatistics statistics = block->allocator.GetStatistics();
+                    freeBytes += statistics.freeBytes;
+
+                    if (!block->pinned && statistics.usedBytes > 0u && statistics.usedBytes < sourceBytes) {
+                        source = i;
+                        sourceBytes = statistics.usedBytes;
+                    }
+                }
+
+                if (source == ~0u) {
+                    continue;
+                }
+
+                // the contents have to fit into the other blocks, with slack for their own fragmentation,
+                // otherwise moving them would only grow the pool
+                uint64_t otherFree = freeBytes - pool.blocks[source]->allocator.GetStatistics().freeBytes;
+                if (sourceBytes > otherFree / 2u) {
+                    continue;
+                }
+
+                pool.blocks[source]->evacuating = true;
+                evacuatingPool = poolIndex;
+                evacuatingBlock = source;
+                return true;
+            }
+
+            return false;
+        }
+
+        void MemoryAllocator::CancelEvacuation() {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (evacuatingPool == ~0u) {
+                return;
+            }
+
+            Block* block = pools[evacuatingPool].blocks[evacuatingBlock].get();
+            block->evacuating = false;
+            block->pinned = true;
+            evacuatingPool = ~0u;
+            evacuatingBlock = ~0u;
+            defragmentationStatistics.cancelled++;
+        }
+
+        bool MemoryAllocator::IsEvacuating() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return evacuatingPool != ~0u;
+        }
+
+        bool MemoryAllocator::IsEvacuating(const Fox::Vulkan::MemoryAllocation& allocation) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return allocation.IsValid() && allocation.pool == evacuatingPool && allocation.block == evacuatingBlock;
+        }
+
+        void MemoryAllocator::RecordMove(VkDeviceSize bytes) {
+            std::lock_guard<std::mutex> lock(mutex);
+            defragmentationStatistics.moves++;
+            defragmentationStatistics.movedBytes += bytes;
+        }
+
+        Fox::Vulkan::DefragmentationStatistics MemoryAllocator::GetDefragmentationStatistics() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return defragmentationStatistics;
+        }
+
+        Fox::Vulkan::MemoryReport MemoryAllocator::GetReport() {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            Fox::Vulkan::MemoryReport report;
+            report.budgetAvailable = renderer->SupportsMemoryBudget();
+
+            VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+            budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+            if (report.budgetAvailable) {
+                VkPhysicalDeviceMemoryProperties2 properties{};
+                properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+                properties.pNext = &budget;
+                vkGetPhysicalDeviceMemoryProperties2(renderer->physicalDevice, &properties);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            report.total = totalUsage;
+            report.categories = categoryUsage;
+
+            report.heaps.resize(memoryProperties.memoryHeapCount);
+            for (uint32_t i = 0u; i < memoryProperties.memoryHeapCount; i++) {
+                Fox::Vulkan::MemoryHeapReport& heap = report.heaps[i];
+                heap.size = memoryProperties.memoryHeaps[i].size;
+                heap.flags = memoryProperties.memoryHeaps[i].flags;
+                heap.allocated = heapUsage[i];
+                heap.budget = budget.heapBudget[i];
+                heap.usage = budget.heapUsage[i];
+            }
+
+            report.memoryTypes.resize(memoryProperties.memoryTypeCount);
+            for (uint32_t i = 0u; i < memoryProperties.memoryTypeCount; i++) {
+                Fox::Vulkan::MemoryTypeReport& memoryType = report.memoryTypes[i];
+                memoryType.heapIndex = memoryProperties.memoryTypes[i].heapIndex;
+                memoryType.flags = memoryProperties.memoryTypes[i].propertyFlags;
+                memoryType.allocated = memoryTypeUsage[i];
+            }
+
+            return report;
+        }
+
+        void MemoryAllocator::WriteReport(const std::string& path) {
+            Fox::Vulkan::MemoryReport report = GetReport();
+            Fox::Vulkan::DefragmentationStatistics defragmentation = GetDefragmentationStatistics();
+
+            std::ofstream file(path, std::ios::trunc);
+            if (!file.is_open()) {
+                std::cout << "Warning: could not write memory report " << path << "." << std::endl;
+                return;
+            }
+
+            auto writeUsage = [&file](const Fox::Vulkan::MemoryUsage& usage) {
+                file << "{ \"bytes\": " << usage.bytes << ", \"peakBytes\": " << usage.peakBytes << ", \"allocations\": " << usage.allocations << " }";
+            };
+
+            file << "{\n";
+            file << "\t\"frame\": " << Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber() << ",\n";
+            file << "\t\"budgetAvailable\": " << (report.budgetAvailable ? "true" : "false") << ",\n";
+            file << "\t\"total\": ";
+            writeUsage(report.total);
+            file << ",\n";
+
+            file << "\t\"categories\": {\n";
+            for (size_t i = 0u; i < report.categories.size(); i++) {
+                file << "\t\t\"" << GetCategoryName(static_cast<Fox::Vulkan::MemoryCategory>(i)) << "\": ";
+                writeUsage(report.categories[i]);
+                file << (i + 1u < report.categories.size() ? ",\n" : "\n");
+            }
+            file << "\t},\n";
+
+            file << "\t\"heaps\": [\n";
+            for (size_t i = 0u; i < report.heaps.size(); i++) {
+                const Fox::Vulkan::MemoryHeapReport& heap = report.heaps[i];
+                file << "\t\t{ \"index\": " << i << ", \"size\": " << heap.size
+                    << ", \"deviceLocal\": " << ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "true" : "false")
+                    << ", \"budget\": " << heap.budget << ", \"usage\": " << heap.usage << ", \"allocated\": ";
+                writeUsage(heap.allocated);
+                file << (i + 1u < report.heaps.size() ? " },\n" : " }\n");
+            }
+            file << "\t],\n";
+
+            file << "\t\"defragmentation\": { \"moves\": " << defragmentation.moves << ", \"movedBytes\": " << defragmentation.movedBytes
+                << ", \"releasedBlocks\": " << defragmentation.releasedBlocks << ", \"reclaimedBytes\": " << defragmentation.reclaimedBytes
+                << ", \"cancelled\": " << defragmentation.cancelled << " },\n";
+
+            file << "\t\"memoryTypes\": [\n";
+            for (size_t i = 0u; i < report.memoryTypes.size(); i++) {
+                const Fox::Vulkan::MemoryTypeReport& memoryType = report.memoryTypes[i];
+                file << "\t\t{ \"index\": " << i << ", \"heap\": " << memoryType.heapIndex << ", \"flags\": " << memoryType.flags << ", \"allocated\": ";
+                writeUsage(memoryType.allocated);
+                file << (i + 1u < report.memoryTypes.size() ? " },\n" : " }\n");
+            }
+            file << "\t]\n";
+            file << "}\n";
+        }
+
+        Fox::Vulkan::MemoryCategory MemoryAllocator::GetBufferCategory(VkBufferUsageFlags usage) {
+            if (usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+                return Fox::Vulkan::MemoryCategory::Uniform;
+            }
+            if (usage & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT)) {
+                return Fox::Vulkan::MemoryCategory::Geometry;
+            }
+            if (usage == VK_BUFFER_USAGE_TRANSFER_SRC_BIT) {
+                return Fox::Vulkan::MemoryCategory::Staging;
+            }
+            return Fox::Vulkan::MemoryCategory::Other;
+        }
+
+        const char* MemoryAllocator::GetCategoryName(Fox::Vulkan::MemoryCategory category) {
+            switch (category) {
+            case Fox::Vulkan::MemoryCategory::Geometry:
+                return "geometry";
+            case Fox::Vulkan::MemoryCategory::Texture:
+                return "texture";
+            case Fox::Vulkan::MemoryCategory::RenderTarget:
+                return "renderTarget";
+            case Fox::Vulkan::MemoryCategory::Uniform:
+                return "uniform";
+            case Fox::Vulkan::MemoryCategory::Staging:
+                return "staging";
+            default:
+                return "other";
+            }
+        }
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		// what an allocation is used for, only for accounting
+		enum class MemoryCategory : uint32_t {
+			Geometry,
+			Texture,
+			RenderTarget,
+			Uniform,
+			Staging,
+			Other,
+			Count
+		};
+
+		// a range of device memory handed out by the MemoryAllocator, bind the resource at memory + offset
+		struct MemoryAllocation {
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+			VkDeviceSize offset = 0u;
+			VkDeviceSize size = 0u;
+			uint32_t memoryType = ~0u;
+			uint32_t pool = ~0u;		// ~0u for dedicated allocations
+			uint32_t block = ~0u;
+			Fox::Core::TlsfAllocator::Allocation range;
+			void* mappedMemory = nullptr;	// host visible memory stays mapped, already offset to the allocation
+			Fox::Vulkan::MemoryCategory category = Fox::Vulkan::MemoryCategory::Other;
+
+			inline bool IsValid() const {
+				return memory != VK_NULL_HANDLE;
+			}
+
+			inline bool IsDedicated() const {
+				return pool == ~0u;
+			}
+		};
+
+		struct MemoryAllocatorStatistics {
+			uint32_t blocks = 0u;
+			uint32_t dedicatedAllocations = 0u;
+			uint32_t allocations = 0u;			// sub-allocations inside blocks
+			uint64_t blockBytes = 0u;
+			uint64_t usedBytes = 0u;			// of the blocks
+			uint64_t dedicatedBytes = 0u;
+		};
+
+		struct DefragmentationStatistics {
+			uint64_t moves = 0u;
+			uint64_t movedBytes = 0u;
+			uint32_t releasedBlocks = 0u;
+			uint64_t reclaimedBytes = 0u;		// device memory given back by evacuated blocks
+			uint32_t cancelled = 0u;			// blocks that held something nobody could move
+		};
+
+		struct MemoryUsage {
+			uint64_t bytes = 0u;
+			uint64_t peakBytes = 0u;
+			uint32_t allocations = 0u;
+
+			void Add(uint64_t size) {
+				bytes += size;
+				peakBytes = std::max(peakBytes, bytes);
+				allocations++;
+			}
+
+			void Remove(uint64_t size) {
+				bytes -= size;
+				allocations--;
+			}
+		};
+
+		// budget and usage come from VK_EXT_memory_budget and include other processes, without it they stay 0
+		struct MemoryHeapReport {
+			VkDeviceSize size = 0u;
+			VkMemoryHeapFlags flags = 0u;
+			Fox::Vulkan::MemoryUsage allocated;		// vkAllocateMemory calls of this allocator
+			VkDeviceSize budget = 0u;
+			VkDeviceSize usage = 0u;
+		};
+
+		struct MemoryTypeReport {
+			uint32_t heapIndex = 0u;
+			VkMemoryPropertyFlags flags = 0u;
+			Fox::Vulkan::MemoryUsage allocated;
+		};
+
+		struct MemoryReport {
+			bool budgetAvailable = false;
+			Fox::Vulkan::MemoryUsage total;			// resources, i.e. the sum of the categories
+			std::array<Fox::Vulkan::MemoryUsage, static_cast<size_t>(Fox::Vulkan::MemoryCategory::Count)> categories;
+			std::vector<Fox::Vulkan::MemoryHeapReport> heaps;
+			std::vector<Fox::Vulkan::MemoryTypeReport> memoryTypes;
+		};
+
+		// Sub-allocates device memory out of large blocks, one TLSF allocator per block. Blocks are kept per memory type
+		// and per resource kind, buffers and linear images never share a block with optimal images so that
+		// bufferImageGranularity can not put both on the same page. Render targets and anything larger than half a block
+		// get a dedicated allocation of their own. Blocks in host visible memory are mapped once for their lifetime.
+		class MemoryAllocator {
+		public:
+			MemoryAllocator(VkDeviceSize blockSize);
+			~MemoryAllocator();
+
+			Fox::Vulkan::MemoryAllocation AllocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties, Fox::Vulkan::MemoryCategory category, bool dedicated = false);
+			Fox::Vulkan::MemoryAllocation AllocateForImage(VkImage image, VkMemoryPropertyFlags properties, bool linear, bool dedicated,
+				Fox::Vulkan::MemoryCategory category);
+			void Free(Fox::Vulkan::MemoryAllocation& allocation);
+
+			// bytes actually backing a lazily allocated allocation, its full size for any other memory
+			VkDeviceSize GetCommittedBytes(const Fox::Vulkan::MemoryAllocation& allocation);
+			bool IsLazilyAllocated(const Fox::Vulkan::MemoryAllocation& allocation) const;
+
+			Fox::Vulkan::MemoryAllocatorStatistics GetStatistics();
+
+			// live and peak bytes per category, memory type and heap, with the driver's budget when available
+			Fox::Vulkan::MemoryReport GetReport();
+			void WriteReport(const std::string& path);
+
+			// Incremental defragmentation. BeginEvacuation picks the emptiest block of a device local pool whose contents fit
+			// into the free space of the other blocks, new allocations avoid it from then on. Owners of resources in it move
+			// them a few per frame and free the old ones, the block is released as soon as it is empty.
+			bool BeginEvacuation();
+			void CancelEvacuation();
+			bool IsEvacuating();
+			bool IsEvacuating(const Fox::Vulkan::MemoryAllocation& allocation);
+			void RecordMove(VkDeviceSize bytes);
+			Fox::Vulkan::DefragmentationStatistics GetDefragmentationStatistics();
+
+			static Fox::Vulkan::MemoryCategory GetBufferCategory(VkBufferUsageFlags usage);
+			static const char* GetCategoryName(Fox::Vulkan::MemoryCategory category);
+
+		private:
+
+			struct Block {
+				VkDeviceMemory memory = VK_NULL_HANDLE;
+				void* mappedMemory = nullptr;
+				Fox::Core::TlsfAllocator allocator;
+				bool evacuating = false;
+				bool pinned = false;		// an evacuation was cancelled, not tried again until something in it is freed
+			};
+
+			struct Pool {
+				uint32_t memoryType = 0u;
+				VkDeviceSize blockSize = 0u;
+				std::vector<std::unique_ptr<Block>> blocks;		// empty slots are reused
+			};
+
+			Fox::Vulkan::MemoryAllocation Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear, bool dedicated,
+				VkBuffer buffer, VkImage image, Fox::Vulkan::MemoryCategory category);
+			uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+			Fox::Vulkan::MemoryAllocation AllocateDedicated(uint32_t memoryType, VkDeviceSize size, VkBuffer buffer, VkImage image);
+			VkDeviceMemory AllocateMemory(uint32_t memoryType, VkDeviceSize size, VkBuffer buffer, VkImage image);
+			void* MapMemory(uint32_t memoryType, VkDeviceMemory memory);
+			void ReleaseMemory(uint32_t memoryType, VkDeviceMemory memory, VkDeviceSize size);
+
+			VkPhysicalDeviceMemoryProperties memoryProperties;
+			VkDeviceSize blockSize;
+			uint32_t maxAllocationCount;
+			uint32_t allocationCount = 0u;		// vkAllocateMemory calls alive
+
+			std::vector<Pool> pools;			// two per memory type, linear first
+			uint32_t dedicatedAllocations = 0u;
+			uint64_t dedicatedBytes = 0u;
+
+			uint32_t evacuatingPool = ~0u;
+			uint32_t evacuatingBlock = ~0u;
+			Fox::Vulkan::DefragmentationStatistics defragmentationStatistics;
+
+			Fox::Vulkan::MemoryUsage totalUsage;
+			std::array<Fox::Vulkan::MemoryUsage, static_cast<size_t>(Fox::Vulkan::MemoryCategory::Count)> categoryUsage;
+			std::vector<Fox::Vulkan::MemoryUsage> memoryTypeUsage;
+			std::vector<Fox::Vulkan::MemoryUsage> heapUsage;
+			std::mutex mutex;
+		};
+	}
+}
@@ -8,18 +8,33 @@ namespace Fox {
 
 		class Renderer;
 
+		template<class V, class I>
+		struct IndexedMeshData {
+			std::vector<V> vertices;
+			std::vector<I> indices;
+			Fox::Vulkan::Bounds bounds;
+		};
+
 		template<class V>
 		class MeshBase {
 		public: 
 			MeshBase() = default;
 			virtual ~MeshBase() {};
 
-			Fox::Vulkan::Buffer<V>* GetVertices() const {
-				return vertices;
+			const Fox::Vulkan::GeometryAllocation& GetGeometry() const {
+				return geometry;
+			}
+
+			uint32_t GetVertexOffset() const {
+				return geometry.vertexOffset;
+			}
+
+			uint32_t GetVertexCount() const {
+				return geometry.vertexCount;
 			}
 
 		protected: 
-			Fox::Vulkan::Buffer<V>* vertices;
+			Fox::Vulkan::GeometryAllocation geometry;
 		};
 
 		template<class V, class I>
@@ -30,55 +45,38 @@ namespace Fox {
 			
 			IndexedMesh(const std::vector<V>& vertices, const std::vector<I>& indices) {
 				Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+				auto* geometryPool = renderer->GetGeometryPool();
 
-				VkDeviceSize vertexBufferSize = sizeof(V) * vertices.size();
-				Fox::Vulkan::Buffer<V> vertexStagingBuffer;
-
-				vertexStagingBuffer.Create(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-				vertexStagingBuffer.SetContents(vertices);
-
-				this->vertices = new Fox::Vulkan::Buffer<V>();
-				this->vertices->Create(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-				this->vertices->SetContents(vertices, false);
-				renderer->CopyBuffer(vertexStagingBuffer.GetBuffer(), this->vertices->GetBuffer(), vertexBufferSize);
-
-				VkDeviceSize indexBufferSize = sizeof(I) * indices.size();
-				Fox::Vulkan::Buffer<I> indexStagingBuffer;
-
-				indexStagingBuffer.Create(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-				indexStagingBuffer.SetContents(indices);
+				if (!geometryPool->Allocate(static_cast<uint32_t>(vertices.size()), static_cast<uint32_t>(indices.size()), this->geometry)) {
+					throw std::runtime_error("Geometry pool is out of space for mesh!");
+				}
 
-				this->indices = new Fox::Vulkan::Buffer<I>();
-				this->indices->Create(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-				this->indices->SetContents(indices, false);
-				renderer->CopyBuffer(indexStagingBuffer.GetBuffer(), this->indices->GetBuffer(), indexBufferSize);
+				geometryPool->Upload(this->geometry, vertices, indices);
+			}
 
+			// adopts a pool range whose contents were uploaded elsewhere, e.g. by the StreamingManager
+			IndexedMesh(const Fox::Vulkan::GeometryAllocation& geometry) {
+				this->geometry = geometry;
 			}
 
 			virtual ~IndexedMesh() {
-				if (this->vertices) {
-					delete this->vertices;
-					this->vertices = nullptr;
-				}
-				if (this->indices) {
-					delete this->indices;
-					this->indices = nullptr;
+				// command buffers of the frames in flight may still draw from the range
+				if (this->geometry.IsValid()) {
+					Fox::Vulkan::Renderer::GetRenderer()->GetGeometryPool()->Release(this->geometry);
 				}
 			}
 
-			Fox::Vulkan::Buffer<I>* GetIndices() {
-				return indices;
+			uint32_t GetFirstIndex() const {
+				return this->geometry.firstIndex;
 			}
 
 			size_t GetIndexCount() const {
-				return indices->GetElementCount();
+				return this->geometry.indexCount;
 			}
-
-		private:
-			Fox::Vulkan::Buffer<I>* indices;
 		};
 	
 
 		using Mesh = Fox::Vulkan::IndexedMesh<Fox::Vulkan::Vertex, uint32_t>;
+		using MeshData = Fox::Vulkan::IndexedMeshData<Fox::Vulkan::Vertex, uint32_t>;
 	}
 }
\ No newline at end of file
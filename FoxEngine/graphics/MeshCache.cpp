@@ -0,0 +1,37 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Vulkan {
+
+        bool MeshCache::Find(const std::string& path, std::shared_ptr<Fox::Vulkan::Mesh>& mesh, Fox::Vulkan::Bounds& bounds) {
+            auto it = entries.find(path);
+            if (it == entries.end()) {
+                return false;
+            }
+
+            mesh = it->second.mesh.lock();
+            if (!mesh) {
+                entries.erase(it);
+                return false;
+            }
+
+            bounds = it->second.bounds;
+            return true;
+        }
+
+        void MeshCache::Insert(const std::string& path, std::shared_ptr<Fox::Vulkan::Mesh> mesh, const Fox::Vulkan::Bounds& bounds) {
+            entries[path] = { mesh, bounds };
+        }
+
+        void MeshCache::Prune() {
+            for (auto it = entries.begin(); it != entries.end();) {
+                if (it->second.mesh.expired()) {
+                    it = entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		// Shares meshes between models loaded from the same file. Entries hold weak references, so a mesh
+		// is released with its last model and the next load of that path imports it again.
+		class MeshCache {
+		public:
+			MeshCache() = default;
+			~MeshCache() = default;
+
+			bool Find(const std::string& path, std::shared_ptr<Fox::Vulkan::Mesh>& mesh, Fox::Vulkan::Bounds& bounds);
+			void Insert(const std::string& path, std::shared_ptr<Fox::Vulkan::Mesh> mesh, const Fox::Vulkan::Bounds& bounds);
+			void Prune();
+
+			inline size_t GetSize() const {
+				return entries.size();
+			}
+
+		private:
+
+			struct Entry {
+				std::weak_ptr<Fox::Vulkan::Mesh> mesh;
+				Fox::Vulkan::Bounds bounds;
+			};
+
+			std::unordered_map<std::string, Entry> entries;
+		};
+	}
+}
@@ -18,17 +18,58 @@ namespace Fox {
     namespace Vulkan {
 
         Model::~Model() {
+            SetTexture("");
+        }
+
+        void Model::SetTexture(const std::string& path) {
+            Fox::Vulkan::TextureManager* textureManager = Fox::Vulkan::Renderer::GetRenderer()->GetTextureManager();
+
+            // acquire before releasing so that re-setting the same path never drops the last reference
+            Fox::Vulkan::Texture* newTexture = path.empty() ? nullptr : textureManager->Acquire(path);
+            if (!texturePath.empty() && textureManager) {
+                textureManager->Release(texturePath);
+            }
+
+            texturePath = path;
+            texture = newTexture;
+            atlas = nullptr;
+            textureRegion = Fox::Vulkan::TextureAtlasRegion();
+        }
+
+        void Model::SetTexture(std::shared_ptr<Fox::Vulkan::TextureAtlas> atlas, const std::string& path) {
+            SetTexture("");
+
+            if (!atlas || !atlas->Find(path, textureRegion)) {
+                std::cout << "Warning: texture " << path << " is not in the atlas." << std::endl;
+                return;
+            }
+
+            this->atlas = atlas;
+            texture = atlas->GetTexture();
         }
 
         void Model::Load(const std::string& path) {
+            Fox::Vulkan::MeshCache* meshCache = Fox::Vulkan::Renderer::GetRenderer()->GetMeshCache();
+            if (meshCache->Find(path, mesh, bounds)) {
+                return;
+            }
+
+            Fox::Vulkan::MeshData data = Import(path);
+            mesh = std::make_shared<Fox::Vulkan::Mesh>(data.vertices, data.indices);
+            bounds = data.bounds;
+            meshCache->Insert(path, mesh, bounds);
+        }
+
+        Fox::Vulkan::MeshData Model::Import(const std::string& path) {
 
             tinyobj::attrib_t attrib;
             std::vector<tinyobj::shape_t> shapes;
             std::vector<tinyobj::material_t> materials;
             std::string warn, err;
 
-            std::vector<Fox::Vulkan::Vertex> vertices;
-            std::vector<uint32_t> indices;
+            Fox::Vulkan::MeshData data;
+            std::vector<Fox::Vulkan::Vertex>& vertices = data.vertices;
+            std::vector<uint32_t>& indices = data.indices;
 
             if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str())) {
                 throw std::runtime_error(warn + err);
@@ -62,7 +103,9 @@ namespace Fox {
 
             }
 
-            mesh = std::make_shared<Fox::Vulkan::Mesh>(vertices, indices);
+            data.bounds = Fox::Vulkan::Bounds::Compute(vertices);
+
+            return data;
         }
     }
 }
\ No newline at end of file
@@ -9,12 +9,12 @@ namespace Fox {
 			Model() {}
 			~Model();
 
-			VkBuffer GetVertexBuffer() {
-				return mesh->GetVertices()->GetBuffer();
+			uint32_t GetVertexOffset() {
+				return mesh->GetVertexOffset();
 			}
 
-			VkBuffer GetIndexBuffer() {
-				return mesh->GetIndices()->GetBuffer();
+			uint32_t GetFirstIndex() {
+				return mesh->GetFirstIndex();
 			}
 
 			size_t GetIndexCount() {
@@ -22,9 +22,42 @@ namespace Fox {
 			}
 
 			void Load(const std::string& path);
+			static Fox::Vulkan::MeshData Import(const std::string& path);
+
+			void SetMesh(std::shared_ptr<Fox::Vulkan::Mesh> mesh, const Fox::Vulkan::Bounds& bounds) {
+				this->mesh = mesh;
+				this->bounds = bounds;
+			}
+
+			bool IsResident() const {
+				return mesh != nullptr;
+			}
+
+			const Fox::Vulkan::Bounds& GetBounds() const {
+				return bounds;
+			}
+
+			void SetTexture(const std::string& path);
+			// samples the region the atlas packed path into, the model keeps the atlas alive
+			void SetTexture(std::shared_ptr<Fox::Vulkan::TextureAtlas> atlas, const std::string& path);
+
+			Fox::Vulkan::Texture* GetTexture() {
+				return texture;
+			}
+
+			const Fox::Vulkan::TextureAtlasRegion& GetTextureRegion() const {
+				return textureRegion;
+			}
+
 		private:
 
 			std::shared_ptr<Mesh> mesh;
+			Fox::Vulkan::Bounds bounds;
+
+			std::string texturePath;
+			Fox::Vulkan::Texture* texture = nullptr;
+			std::shared_ptr<Fox::Vulkan::TextureAtlas> atlas;
+			Fox::Vulkan::TextureAtlasRegion textureRegion;
 		};
 	}
 }
\ No newline at end of file
@@ -4,9 +4,19 @@ namespace Fox {
 
 	namespace Vulkan {
 
-		void ModelNode::LoadModel(std::string modelPath) {
+		void ModelNode::LoadModel(std::string modelPath, std::string texturePath) {
 			model = std::make_shared<Fox::Vulkan::Model>();
-			model->Load(modelPath);
+			model->SetTexture(texturePath);
+			Fox::Vulkan::Renderer::GetRenderer()->GetStreamingManager()->RequestModel(model, modelPath);
+		}
+
+		void ModelNode::UpdateWorldTransform() {
+			Fox::Vulkan::SceneNode::UpdateWorldTransform();
+
+			worldBoundsValid = model && model->IsResident();
+			if (worldBoundsValid) {
+				worldBounds = model->GetBounds().Transform(worldTransform);
+			}
 		}
 	
 	}
@@ -15,13 +15,26 @@ namespace Fox {
 				model = nullptr;
 			}
 
-			void LoadModel(std::string modelPath);
+			void LoadModel(std::string modelPath, std::string texturePath = "");
 			Fox::Vulkan::Model* GetModel() {
 				return model.get();
 			}
 
+			void UpdateWorldTransform() override;
+
+			// valid once the model is resident and the node has been updated
+			const Fox::Vulkan::Bounds& GetWorldBounds() const {
+				return worldBounds;
+			}
+
+			bool HasWorldBounds() const {
+				return worldBoundsValid;
+			}
+
 		private: 
 			std::shared_ptr<Fox::Vulkan::Model> model;
+			Fox::Vulkan::Bounds worldBounds;
+			bool worldBoundsValid = false;
 		};
 	}
 }
\ No newline at end of file
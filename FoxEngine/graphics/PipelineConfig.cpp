@@ -522,6 +522,40 @@ namespace Fox {
 
 			Fox::Core::Json::StringValue& vertexTypeString = root.Get<Fox::Core::Json::StringValue>("vertexType");
 			vertexType = vertexTypeString.value;
+
+			if (root.Has("bindless")) {
+				bindless = root.Get<Fox::Core::Json::BoolValue>("bindless").GetValue();
+			}
+
+			if (root.Has("indirect")) {
+				indirect = root.Get<Fox::Core::Json::BoolValue>("indirect").GetValue();
+			}
+
+			if (root.Has("sampler")) {
+				sampler = Fox::Vulkan::SamplerManager::ReadDescription(root.Get<Fox::Core::Json::JSONObject>("sampler"));
+			}
+
+			if (root.Has("pushConstants")) {
+				Fox::Core::Json::JSONValueArray& pushConstantsArray = root.Get<Fox::Core::Json::JSONValueArray>("pushConstants");
+
+				for (size_t i = 0u; i < pushConstantsArray.Size(); i++) {
+					Fox::Core::Json::JSONObject& pushConstantData = pushConstantsArray.Get<Fox::Core::Json::JSONObject>(i);
+					Fox::Core::Json::JSONValueArray& stagesArray = pushConstantData.Get<Fox::Core::Json::JSONValueArray>("stages");
+
+					Fox::Vulkan::PushConstantConfig pushConstant{};
+					for (size_t j = 0u; j < stagesArray.Size(); j++) {
+						Fox::Core::Json::StringValue& stageString = stagesArray.Get<Fox::Core::Json::StringValue>(j);
+						pushConstant.stages |= Fox::Vulkan::ShaderConfig::ToVulkanShader(Fox::Vulkan::ShaderConfig::GetShaderType(stageString.value));
+					}
+					pushConstant.offset = static_cast<uint32_t>(pushConstantData.Get<Fox::Core::Json::IntValue>("offset").GetValue());
+					pushConstant.size = static_cast<uint32_t>(pushConstantData.Get<Fox::Core::Json::IntValue>("size").GetValue());
+
+					if (pushConstant.size == 0u || pushConstant.offset % 4u != 0u || pushConstant.size % 4u != 0u) {
+						throw std::runtime_error("Push constant range of pipeline " + path + " has to be a non-empty multiple of 4 bytes!");
+					}
+					pushConstants.push_back(pushConstant);
+				}
+			}
 		}
 	}
 }
@@ -204,6 +204,13 @@ namespace Fox {
 			uint32_t writeMask;
 			uint32_t reference;
 		};
+
+		// a range of the pipeline layout's push constants, offset and size in bytes and multiples of 4
+		struct PushConstantConfig {
+			VkShaderStageFlags stages;
+			uint32_t offset;
+			uint32_t size;
+		};
 	
 		struct PipelineConfig {
 
@@ -274,6 +281,19 @@ namespace Fox {
 			Fox::Vulkan::StencilOperationState frontState;
 			Fox::Vulkan::StencilOperationState backState;
 
+			// sampler used for the textures drawn with this pipeline, optional
+			Fox::Vulkan::SamplerDescription sampler;
+
+			// reads textures from the bindless table in set 1, the pipeline is skipped without descriptor indexing
+			bool bindless = false;
+
+			// per-draw data pushed with vkCmdPushConstants, optional
+			std::vector<Fox::Vulkan::PushConstantConfig> pushConstants;
+
+			// reads per-draw data from the frame's draw data buffer through the draw index of its instances, so the whole
+			// queue can be drawn with indirect draws
+			bool indirect = false;
+
 			std::string vertexType;
 		};
 
@@ -0,0 +1,64 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Vulkan {
+
+        namespace {
+            const uint32_t LAYER_BITS = 4u;
+            const uint32_t PIPELINE_BITS = 8u;
+            const uint32_t MATERIAL_BITS = 16u;
+            const uint32_t MESH_BITS = 12u;
+            const uint32_t DEPTH_BITS = 24u;
+
+            inline uint64_t Field(uint32_t value, uint32_t bits) {
+                return static_cast<uint64_t>(value) & ((1ull << bits) - 1u);
+            }
+        }
+
+        void RenderQueue::Clear() {
+            items.clear();
+        }
+
+        void RenderQueue::Push(uint64_t key, uint32_t value) {
+            items.push_back({ key, value });
+        }
+
+        void RenderQueue::Sort() {
+            if (scratch.size() < items.size()) {
+                scratch.resize(items.capacity());
+            }
+            Fox::Core::RadixSort::Sort(items.data(), scratch.data(), items.size());
+        }
+
+        uint64_t RenderQueue::MakeKey(Fox::Vulkan::RenderLayer layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+            uint32_t quantizedDepth = static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>((1u << DEPTH_BITS) - 1u));
+
+            uint64_t state = (Field(pipeline, PIPELINE_BITS) << (MATERIAL_BITS + MESH_BITS)) | (Field(material, MATERIAL_BITS) << MESH_BITS) |
+                Field(mesh, MESH_BITS);
+            uint64_t key = Field(static_cast<uint32_t>(layer), LAYER_BITS) << (64u - LAYER_BITS);
+
+            if (layer == Fox::Vulkan::RenderLayer::Transparent) {
+                uint32_t backToFront = ((1u << DEPTH_BITS) - 1u) - quantizedDepth;
+                return key | (Field(backToFront, DEPTH_BITS) << (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS)) | state;
+            }
+            return key | (state << DEPTH_BITS) | Field(quantizedDepth, DEPTH_BITS);
+        }
+
+        uint32_t RenderQueue::GetPipelineId(VkPipeline pipeline) {
+            return GetId(pipelineIds, (uint64_t)pipeline);
+        }
+
+        uint32_t RenderQueue::GetMaterialId(const Fox::Vulkan::Texture* texture) {
+            return GetId(materialIds, reinterpret_cast<uintptr_t>(texture));
+        }
+
+        uint32_t RenderQueue::GetMeshId(const Fox::Vulkan::Model* model) {
+            return GetId(meshIds, reinterpret_cast<uintptr_t>(model));
+        }
+
+        uint32_t RenderQueue::GetId(std::unordered_map<uint64_t, uint32_t>& ids, uint64_t handle) {
+            return ids.try_emplace(handle, static_cast<uint32_t>(ids.size())).first->second;
+        }
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		class Texture;
+		class Model;
+
+		enum class RenderLayer : uint32_t {
+			Opaque = 0u,
+			Transparent = 1u,
+			Overlay = 2u
+		};
+
+		// Draw items sorted by a packed 64-bit key, most significant field first:
+		//   opaque:       layer 4 | pipeline 8 | material 16 | mesh 12 | depth 24, nearest first
+		//   transparent:  layer 4 | depth 24, farthest first | pipeline 8 | material 16 | mesh 12
+		// so opaque draws change state as rarely as possible and front-to-back order only breaks ties, while transparent
+		// ones are blended in order. Ids wrap when more are in use than their field holds, which only costs extra state changes.
+		// The queue keeps its arrays between frames, once they have grown to the largest frame nothing is allocated.
+		class RenderQueue {
+		public:
+			RenderQueue() = default;
+			~RenderQueue() = default;
+
+			void Clear();
+			// value is handed back in sorted order, usually an index into the caller's draws
+			void Push(uint64_t key, uint32_t value);
+			void Sort();
+
+			inline const std::vector<Fox::Core::SortItem>& GetItems() const {
+				return items;
+			}
+
+			// depth is the view space distance mapped to [0, 1]
+			static uint64_t MakeKey(Fox::Vulkan::RenderLayer layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth);
+
+			// small ids for the key fields, stable for the lifetime of the queue
+			uint32_t GetPipelineId(VkPipeline pipeline);
+			uint32_t GetMaterialId(const Fox::Vulkan::Texture* texture);
+			uint32_t GetMeshId(const Fox::Vulkan::Model* model);
+
+		private:
+			static uint32_t GetId(std::unordered_map<uint64_t, uint32_t>& ids, uint64_t handle);
+
+			std::vector<Fox::Core::SortItem> items;
+			std::vector<Fox::Core::SortItem> scratch;
+
+			std::unordered_map<uint64_t, uint32_t> pipelineIds;
+			std::unordered_map<uint64_t, uint32_t> materialIds;
+			std::unordered_map<uint64_t, uint32_t> meshIds;
+		};
+	}
+}
@@ -30,6 +30,7 @@ namespace Fox {
         }
 
         void Renderer::Initialize() {
+            threadPool = std::make_unique<Fox::Core::ThreadPool>(config.workerThreads);
             swapchain = std::make_unique<Fox::Vulkan::Swapchain>();
             descriptorManager = std::make_unique<Fox::Vulkan::DescriptorSetManager>(MAX_FRAMES_IN_FLIGHT);
             graphicsPipelineState = std::make_unique<Fox::Vulkan::GraphicsPipelineStateManager>();
@@ -37,26 +38,33 @@ namespace Fox {
 
             PickPhysicalDevice();
             CreateLogicalDevice();
+            memoryAllocator = std::make_unique<Fox::Vulkan::MemoryAllocator>(config.memoryBlockSize);
+            stagingPool = std::make_unique<Fox::Vulkan::StagingPool>(config.stagingBlockSize, config.maxStagingBlocks);
             swapchain->Create();
             renderPassManager->CreateRenderPass();
             descriptorManager->CreateDescriptorSetLayouts();
             graphicsPipelineState->CreateGraphicsPipelines();
             CreateCommandPool();
-            swapchain->CreateColorResources();
-            swapchain->CreateDepthResources();
+            geometryPool = std::make_unique<Fox::Vulkan::GeometryPool<Fox::Vulkan::Vertex, uint32_t>>(config.maxPooledVertices, config.maxPooledIndices,
+                MAX_FRAMES_IN_FLIGHT);
+            meshCache = std::make_unique<Fox::Vulkan::MeshCache>();
+            streamingManager = std::make_unique<Fox::Vulkan::StreamingManager>();
+            swapchain->CreateAttachments();
             swapchain->CreateFrameBuffers(renderPassManager->GetRenderPass());
 
-            textureManager = std::make_unique<Fox::Vulkan::TextureManager>();
-            textureManager->CreateTextures(mipLevels);
+            textureManager = std::make_unique<Fox::Vulkan::TextureManager>(MAX_FRAMES_IN_FLIGHT);
+            textureManager->CreateTextures();
+            mipLevels = textureManager->GetMaxMipLevels();
 
             samplerManager = std::make_unique<Fox::Vulkan::SamplerManager>(mipLevels);
             samplerManager->CreateSamplers();
 
 
             sceneGraph = std::make_shared<Fox::Vulkan::SceneGraph>();
-            sceneGraph->AddChild("model", glm::vec3(0.0f, 0.0f, -1.0f), glm::quat(0.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f), MODEL_PATH);
+            sceneGraph->AddChild("model", glm::vec3(0.0f, 0.0f, -1.0f), glm::quat(0.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f), MODEL_PATH, TEXTURE_PATH);
             model = sceneGraph->Find("model");
 
+            uploadRing = std::make_unique<Fox::Vulkan::UploadRing>(config.uploadRingSize, MAX_FRAMES_IN_FLIGHT);
             constantBuffers = std::make_unique<Fox::Vulkan::ConstantBuffers>();
             constantBuffers->CreateUniformBuffers(MAX_FRAMES_IN_FLIGHT);
 
@@ -69,7 +77,11 @@ namespace Fox {
 
         void Renderer::Destroy() {
 
+            streamingManager = nullptr;
+            sceneGraph->Destroy();
+            sceneGraph = nullptr;
             constantBuffers = nullptr;
+            uploadRing = nullptr;
             swapchain->Cleanup();
 
             textureManager = nullptr;
@@ -77,14 +89,23 @@ namespace Fox {
             descriptorManager = nullptr;
             synchronization = nullptr;
 
+            for (RecordingContext& context : recordingContexts) {
+                for (VkCommandPool pool : context.commandPools) {
+                    vkDestroyCommandPool(device, pool, nullptr);
+                }
+            }
+            recordingContexts.clear();
             vkDestroyCommandPool(device, commandPool, nullptr);
 
             graphicsPipelineState = nullptr;
             renderPassManager = nullptr;
-            sceneGraph->Destroy();
-            sceneGraph = nullptr;
+            meshCache = nullptr;
+            geometryPool = nullptr;
+            stagingPool = nullptr;
+            memoryAllocator = nullptr;
 
             vkDestroyDevice(device, nullptr);
+            threadPool = nullptr;
 
             if (enableValidationLayers) {
                 DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
@@ -116,6 +137,15 @@ namespace Fox {
 
             synchronization->ResetFence(device, currentFrame);
 
+            // the fence covers everything the frame read from its partition
+            uploadRing->BeginFrame(currentFrame);
+
+            geometryPool->CollectGarbage(frameNumber);
+            textureManager->CollectGarbage(frameNumber);
+            textureManager->UpdateStreaming();
+            textureManager->Defragment(frameNumber);
+            streamingManager->Update();
+
             angle += 0.05f;
             model->SetRotation(0.0f, 0.0f, -angle);
             model->SetPosition(angle * 0.001f, 0.0f, 0.0f);
@@ -127,17 +157,23 @@ namespace Fox {
 
             sceneGraph->ForEach([=](std::shared_ptr<Fox::Vulkan::SceneNode> node) {
                 Fox::Vulkan::SceneNode* sceneNode = node.get();
-                Fox::Vulkan::ModelNode* modelNode = static_cast<Fox::Vulkan::ModelNode*>(sceneNode);
-                if (modelNode) {
+                Fox::Vulkan::ModelNode* modelNode = dynamic_cast<Fox::Vulkan::ModelNode*>(sceneNode);
+                if (modelNode && modelNode->GetModel() && modelNode->GetModel()->IsResident()) {
                     batches.push_back({ modelNode->GetModel(), modelNode->worldTransform });
                 }
             });
 
+            // the camera is needed for sorting, the frame's uniform buffer is free since its fence has signalled
+            constantBuffers->SyncPerFrame(currentFrame);
+
+            if (!BuildInstancedBatches()) {
+                instancedBatches.clear();
+            }
+            SortInstancedBatches();
+
             vkResetCommandBuffer(commandBuffers[currentFrame], 0);
             RecordCommandBuffer(commandBuffers[currentFrame], imageIndex);
 
-            constantBuffers->SyncPerFrame(currentFrame);
-
             VkSubmitInfo submitInfo{};
             submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
@@ -182,11 +218,88 @@ namespace Fox {
                 throw std::runtime_error("failed to present swap chain image!");
             }
 
+            if (config.memoryReportInterval > 0u && frameNumber % config.memoryReportInterval == 0u) {
+                memoryAllocator->WriteReport(config.memoryReportPath);
+            }
+
             currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+            frameNumber++;
             
         
         }
 
+        bool Renderer::BuildInstancedBatches() {
+            instancedBatches.clear();
+            instancedBatchIndices.clear();
+            if (batches.empty()) {
+                return true;
+            }
+
+            // count the instances of every model in the order the models are first met
+            for (const Fox::Vulkan::Batch& batch : batches) {
+                auto it = instancedBatchIndices.try_emplace(batch.model, static_cast<uint32_t>(instancedBatches.size())).first;
+                if (it->second == instancedBatches.size()) {
+                    instancedBatches.push_back({ batch.model });
+                }
+                instancedBatches[it->second].instanceCount++;
+            }
+
+            // instances and draw data are bound at the start of the frame's partition and indexed from there, so both are
+            // aligned to their element size
+            Fox::Vulkan::UploadAllocation allocation = uploadRing->Allocate(sizeof(Fox::Vulkan::PerInstanceData) * batches.size(), sizeof(Fox::Vulkan::PerInstanceData));
+            Fox::Vulkan::UploadAllocation drawAllocation = uploadRing->Allocate(sizeof(Fox::Vulkan::PerObjectConstantBuffer) * instancedBatches.size(),
+                sizeof(Fox::Vulkan::PerObjectConstantBuffer));
+            if (!allocation.IsValid() || !drawAllocation.IsValid()) {
+                drawData = nullptr;
+                return false;
+            }
+
+            VkDeviceSize partitionOffset = uploadRing->GetPartitionOffset();
+            instanceOffset = static_cast<uint32_t>(partitionOffset);
+            drawData = static_cast<Fox::Vulkan::PerObjectConstantBuffer*>(drawAllocation.data);
+            firstDrawIndex = static_cast<uint32_t>((drawAllocation.offset - partitionOffset) / sizeof(Fox::Vulkan::PerObjectConstantBuffer));
+
+            uint32_t instanceBase = static_cast<uint32_t>((allocation.offset - partitionOffset) / sizeof(Fox::Vulkan::PerInstanceData));
+            uint32_t firstInstance = instanceBase;
+            for (Fox::Vulkan::InstancedBatch& instancedBatch : instancedBatches) {
+                instancedBatch.firstInstance = firstInstance;
+                firstInstance += instancedBatch.instanceCount;
+                instancedBatch.instanceCount = 0u;
+            }
+
+            const glm::mat4& view = constantBuffers->GetView();
+            Fox::Vulkan::PerInstanceData* instances = static_cast<Fox::Vulkan::PerInstanceData*>(allocation.data);
+            for (const Fox::Vulkan::Batch& batch : batches) {
+                uint32_t batchIndex = instancedBatchIndices[batch.model];
+                Fox::Vulkan::InstancedBatch& instancedBatch = instancedBatches[batchIndex];
+                Fox::Vulkan::PerInstanceData& instance = instances[instancedBatch.firstInstance - instanceBase + instancedBatch.instanceCount++];
+                instance.model = batch.matrix;
+                instance.drawIndex = firstDrawIndex + batchIndex;
+                instancedBatch.depth = std::min(instancedBatch.depth, -(view * batch.matrix[3]).z);
+            }
+
+            return true;
+        }
+
+        void Renderer::SortInstancedBatches() {
+            renderQueue.Clear();
+
+            uint32_t pipeline = renderQueue.GetPipelineId(graphicsPipelineState->GetCurrentPipelineState());
+            float nearPlane = constantBuffers->GetNearPlane();
+            float depthRange = constantBuffers->GetFarPlane() - nearPlane;
+
+            // nothing is flagged as transparent yet, every model goes to the opaque layer
+            for (uint32_t i = 0u; i < instancedBatches.size(); i++) {
+                const Fox::Vulkan::InstancedBatch& batch = instancedBatches[i];
+                uint32_t material = renderQueue.GetMaterialId(batch.model->GetTexture() ? batch.model->GetTexture() : textureManager->GetDefaultTexture());
+                float depth = (batch.depth - nearPlane) / depthRange;
+
+                renderQueue.Push(Fox::Vulkan::RenderQueue::MakeKey(Fox::Vulkan::RenderLayer::Opaque, pipeline, material, renderQueue.GetMeshId(batch.model), depth), i);
+            }
+
+            renderQueue.Sort();
+        }
+
         void Renderer::RenderBegin(VkCommandBuffer commandBuffer) {
             VkCommandBufferBeginInfo beginInfo{};
             beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -207,37 +320,201 @@ namespace Fox {
         void Renderer::RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
            
             RenderBegin(commandBuffer);
-            RenderPassBegin(commandBuffer, { 0.0f, 0.0f, 0.0f, 1.0f }, 1.0f, 0, renderPassManager->GetRenderPass(), swapchain->GetFramebuffer(imageIndex), {0, 0}, swapchain->GetExtent());
+            streamingManager->RecordOwnershipTransfers(commandBuffer);
+            textureManager->RecordMoves(commandBuffer);
+            PrepareDraws();
+
+            // large frames are split into chunks recorded into secondary buffers in parallel, small ones are not worth it
+            uint32_t chunkCount = 1u;
+            if (indirectDraws.drawCount == 0u && drawCommands.size() >= config.parallelRecordingThreshold) {
+                chunkCount = static_cast<uint32_t>(std::min<size_t>(recordingContexts.size(), drawCommands.size() / std::max(config.parallelRecordingThreshold / 2u, 1u)));
+            }
+
+            VkFramebuffer framebuffer = swapchain->GetFramebuffer(imageIndex);
+            RenderPassBegin(commandBuffer, { 0.0f, 0.0f, 0.0f, 1.0f }, 1.0f, 0, renderPassManager->GetRenderPass(), framebuffer, {0, 0}, swapchain->GetExtent(),
+                chunkCount > 1u ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+
+            if (chunkCount > 1u) {
+                std::vector<VkCommandBuffer> secondaryBuffers(chunkCount);
+                size_t chunkSize = (drawCommands.size() + chunkCount - 1u) / chunkCount;
+
+                // a chunk index is claimed by exactly one thread, so the context's pool is only ever used by one thread at a time
+                threadPool->ParallelFor(chunkCount, [&](uint32_t chunk) {
+                    RecordingContext& context = recordingContexts[chunk];
+                    vkResetCommandPool(device, context.commandPools[currentFrame], 0);
+
+                    VkCommandBufferInheritanceInfo inheritanceInfo{};
+                    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+                    inheritanceInfo.renderPass = renderPassManager->GetRenderPass();
+                    inheritanceInfo.subpass = 0;
+                    inheritanceInfo.framebuffer = framebuffer;
+
+                    VkCommandBufferBeginInfo beginInfo{};
+                    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+                    VkCommandBuffer secondary = context.commandBuffers[currentFrame];
+                    if (vkBeginCommandBuffer(secondary, &beginInfo) != VK_SUCCESS) {
+                        throw std::runtime_error("Failed to begin recording secondary command buffer!");
+                    }
+
+                    size_t begin = chunk * chunkSize;
+                    RecordDraws(secondary, begin, std::min(begin + chunkSize, drawCommands.size()));
+                    RenderEnd(secondary);
+                    secondaryBuffers[chunk] = secondary;
+                });
 
+                vkCmdExecuteCommands(commandBuffer, chunkCount, secondaryBuffers.data());
+            } else {
+                RecordDraws(commandBuffer, 0u, drawCommands.size());
+            }
+
+            RenderPassEnd(commandBuffer);
+            RenderEnd(commandBuffer);
+        }
+
+        void Renderer::PrepareDraws() {
+            drawCommands.clear();
+            uint32_t previouslyDropped = droppedDraws;
+            droppedDraws = 0u;
+
+            // bindless pipelines index textures per draw and keep the default texture's set 0
+            bool bindless = graphicsPipelineState->IsCurrentPipelineBindless();
+            bool pushPerObject = graphicsPipelineState->GetCurrentPushConstantStages(0u, sizeof(Fox::Vulkan::PerObjectConstantBuffer)) != 0u;
+            VkDescriptorSet defaultSet = *descriptorManager->GetAddressOfDescriptorSet(currentFrame, textureManager->GetDefaultTexture());
+            // indirect pipelines find their per-object data in the draw data buffer
+            bool perDrawData = graphicsPipelineState->IsCurrentPipelineIndirect();
+
+            for (const Fox::Core::SortItem& item : renderQueue.GetItems()) {
+                Fox::Vulkan::InstancedBatch& batch = instancedBatches[item.value];
+                Fox::Vulkan::Texture* texture = batch.model->GetTexture() ? batch.model->GetTexture() : textureManager->GetDefaultTexture();
+
+                Fox::Vulkan::DrawCommand draw;
+                draw.batch = &batch;
+                draw.descriptorSet = defaultSet;
+                if (bindless) {
+                    batch.textureIndex = descriptorManager->GetTextureIndex(texture);
+                } else {
+                    draw.descriptorSet = *descriptorManager->GetAddressOfDescriptorSet(currentFrame, texture);
+                }
+
+                draw.perObject = Fox::Vulkan::ConstantBuffers::GetPerObjectData(batch);
+                draw.dynamicOffsets = { 0u, instanceOffset, instanceOffset };
+                if (perDrawData) {
+                    drawData[item.value] = draw.perObject;
+                } else if (!pushPerObject && !constantBuffers->SyncPerObject(batch, draw.dynamicOffsets[0])) {
+                    // the pipeline has no push constant range to fall back to and every later draw needs the same space
+                    droppedDraws = static_cast<uint32_t>(renderQueue.GetItems().size() - drawCommands.size());
+                    if (droppedDraws != previouslyDropped) {
+                        std::cout << "Warning: per-object data does not fit into the upload ring, " << droppedDraws << " draws were dropped." << std::endl;
+                    }
+                    break;
+                }
+                drawCommands.push_back(draw);
+            }
+
+            drawCalls = static_cast<uint32_t>(drawCommands.size());
+            indirectDraws = IndirectDraws();
+            if (!perDrawData || !indirectDrawsSupported || drawCommands.empty()) {
+                return;
+            }
+
+            // the sorted draws go to the upload ring as indirect commands, drawn with one call per maxDrawIndirectCount of them,
+            // without room for them they are recorded one by one
+            uint32_t drawCount = static_cast<uint32_t>(drawCommands.size());
+            uint32_t callCount = (drawCount + maxDrawIndirectCount - 1u) / maxDrawIndirectCount;
+
+            Fox::Vulkan::UploadAllocation commands = uploadRing->Allocate(sizeof(VkDrawIndexedIndirectCommand) * drawCount, sizeof(uint32_t));
+            if (!commands.IsValid()) {
+                return;
+            }
+
+            VkDrawIndexedIndirectCommand* command = static_cast<VkDrawIndexedIndirectCommand*>(commands.data);
+            for (const Fox::Vulkan::DrawCommand& draw : drawCommands) {
+                command->indexCount = static_cast<uint32_t>(draw.batch->model->GetIndexCount());
+                command->instanceCount = draw.batch->instanceCount;
+                command->firstIndex = draw.batch->model->GetFirstIndex();
+                command->vertexOffset = static_cast<int32_t>(draw.batch->model->GetVertexOffset());
+                command->firstInstance = draw.batch->firstInstance;
+                command++;
+            }
+
+            indirectDraws.commandOffset = commands.offset;
+            indirectDraws.drawCount = drawCount;
+            drawCalls = callCount;
+        }
+
+        void Renderer::RecordDraws(VkCommandBuffer commandBuffer, size_t begin, size_t end) {
             SetGraphicsPipeline(commandBuffer, graphicsPipelineState->GetCurrentPipelineState());
             SetViewport(commandBuffer, 0.0f, 0.0f, static_cast<float>(swapchain->GetExtent().width), static_cast<float>(swapchain->GetExtent().height), 0.0f, 1.0f);
             SetScissor(commandBuffer, { 0, 0 }, swapchain->GetExtent());
 
-            for (auto batch : batches) {
-                VkDeviceSize offsets[] = { 0 };
-                std::vector<VkBuffer> vertexBuffers;
-                vertexBuffers.push_back(batch.model->GetVertexBuffer());
-                SetVertexBuffers(commandBuffer, vertexBuffers, 0, offsets);
+            VkDeviceSize offsets[] = { 0 };
+            std::vector<VkBuffer> vertexBuffers;
+            vertexBuffers.push_back(geometryPool->GetVertexBuffer());
+            SetVertexBuffers(commandBuffer, vertexBuffers, 0, offsets);
+            SetIndexBuffer(commandBuffer, geometryPool->GetIndexBuffer(), 0, geometryPool->GetIndexType());
+
+            // bindless pipelines bind the texture table once and index textures per draw
+            if (graphicsPipelineState->IsCurrentPipelineBindless()) {
+                SetDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, 1, 1, descriptorManager->GetAddressOfBindlessDescriptorSet());
+            }
+
+            if (begin < end && indirectDraws.drawCount > 0u) {
+                RecordIndirectDraws(commandBuffer, drawCommands[begin]);
+                return;
+            }
+
+            // pipelines declaring push constants for the per-object data get it pushed and indirect pipelines read it from the draw data buffer,
+            // set 0 is then bound only when its texture changes, otherwise every draw has its own slot of per-object data and set 0 is
+            // rebound with the slot as dynamic offset
+            bool pushPerObject = graphicsPipelineState->GetCurrentPushConstantStages(0u, sizeof(Fox::Vulkan::PerObjectConstantBuffer)) != 0u;
+            bool perDrawData = graphicsPipelineState->IsCurrentPipelineIndirect();
+            VkDescriptorSet boundSet = VK_NULL_HANDLE;
 
-                SetIndexBuffer(commandBuffer, batch.model->GetIndexBuffer(), 0, VK_INDEX_TYPE_UINT32);
-                SetDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, 1, descriptorManager->GetAddressOfDescriptorSet(currentFrame));
+            for (size_t i = begin; i < end; i++) {
+                const Fox::Vulkan::DrawCommand& draw = drawCommands[i];
+
+                if (!(pushPerObject || perDrawData) || draw.descriptorSet != boundSet) {
+                    SetDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, 1, &draw.descriptorSet,
+                        static_cast<uint32_t>(draw.dynamicOffsets.size()), draw.dynamicOffsets.data());
+                    boundSet = draw.descriptorSet;
+                }
+                if (pushPerObject) {
+                    PushConstants(commandBuffer, draw.perObject);
+                }
 
                 if (graphicsPipelineState->RenderWideLines()) {
                     vkCmdSetLineWidth(commandBuffer, graphicsPipelineState->GetCurrentLineWidth());
                 }
 
-                constantBuffers->SyncPerObject(currentFrame, batch);
-
-                DrawIndexed(commandBuffer, static_cast<uint32_t>(batch.model->GetIndexCount()), 1, 0, 0, 0);   
+                const Fox::Vulkan::InstancedBatch& batch = *draw.batch;
+                DrawIndexed(commandBuffer, static_cast<uint32_t>(batch.model->GetIndexCount()), batch.instanceCount, batch.model->GetFirstIndex(),
+                    static_cast<int32_t>(batch.model->GetVertexOffset()), batch.firstInstance);
             }
+        }
 
-            
+        void Renderer::RecordIndirectDraws(VkCommandBuffer commandBuffer, const Fox::Vulkan::DrawCommand& draw) {
+            // every draw of an indirect pipeline shares set 0, the instances lead each draw to its draw data
+            SetDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, 0, 1, &draw.descriptorSet,
+                static_cast<uint32_t>(draw.dynamicOffsets.size()), draw.dynamicOffsets.data());
 
-            RenderPassEnd(commandBuffer);
-            RenderEnd(commandBuffer);
+            if (graphicsPipelineState->RenderWideLines()) {
+                vkCmdSetLineWidth(commandBuffer, graphicsPipelineState->GetCurrentLineWidth());
+            }
+
+            VkBuffer buffer = uploadRing->GetBuffer();
+            uint32_t stride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+            for (uint32_t firstDraw = 0u; firstDraw < indirectDraws.drawCount; firstDraw += maxDrawIndirectCount) {
+                uint32_t drawCount = std::min(maxDrawIndirectCount, indirectDraws.drawCount - firstDraw);
+                VkDeviceSize offset = indirectDraws.commandOffset + static_cast<VkDeviceSize>(firstDraw) * stride;
+                vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
+            }
         }
 
-        void Renderer::RenderPassBegin(VkCommandBuffer commandBuffer, VkClearColorValue clearColor, float clearDepth, uint32_t clearStencil, VkRenderPass renderPass, VkFramebuffer framebuffer, VkOffset2D renderAreaOffset, VkExtent2D renderArea) {
+        void Renderer::RenderPassBegin(VkCommandBuffer commandBuffer, VkClearColorValue clearColor, float clearDepth, uint32_t clearStencil, VkRenderPass renderPass, VkFramebuffer framebuffer, VkOffset2D renderAreaOffset, VkExtent2D renderArea,
+            VkSubpassContents contents) {
             VkRenderPassBeginInfo renderPassInfo{};
             renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
             renderPassInfo.renderPass = renderPass;
@@ -251,7 +528,7 @@ namespace Fox {
             renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
             renderPassInfo.pClearValues = clearValues.data();
 
-            vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+            vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
         }
 
         void Renderer::RenderPassEnd(VkCommandBuffer commandBuffer) {
@@ -293,9 +570,20 @@ namespace Fox {
             vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
         }
 
-        void Renderer::SetDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* descriptorSets) {
+        bool Renderer::PushConstants(VkCommandBuffer commandBuffer, uint32_t offset, uint32_t size, const void* data) {
+            VkShaderStageFlags stages = graphicsPipelineState->GetCurrentPushConstantStages(offset, size);
+            if (stages == 0u) {
+                return false;
+            }
+
+            vkCmdPushConstants(commandBuffer, graphicsPipelineState->GetCurrentPipelineStateLayout(), stages, offset, size, data);
+            return true;
+        }
+
+        void Renderer::SetDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* descriptorSets,
+            uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets) {
             vkCmdBindDescriptorSets(commandBuffer, bindPoint, graphicsPipelineState->GetCurrentPipelineStateLayout(), firstSet, descriptorSetCount,
-                descriptorSets, 0, nullptr);
+                descriptorSets, dynamicOffsetCount, dynamicOffsets);
         }
 
         bool Renderer::HasStencilComponent(VkFormat format) {
@@ -325,9 +613,14 @@ namespace Fox {
             throw std::runtime_error("Failed to find supported format!");
         }
 
-        void Renderer::TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels) {
+        void Renderer::TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount) {
             VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
+            TransitionImageLayout(commandBuffer, image, format, oldLayout, newLayout, mipLevels, layerCount);
+            EndSingleTimeCommands(commandBuffer);
+        }
 
+        void Renderer::TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels,
+            uint32_t layerCount) {
             VkImageMemoryBarrier barrier{};
             barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
             barrier.oldLayout = oldLayout;
@@ -339,7 +632,7 @@ namespace Fox {
             barrier.subresourceRange.baseMipLevel = 0;
             barrier.subresourceRange.levelCount = mipLevels;
             barrier.subresourceRange.baseArrayLayer = 0;
-            barrier.subresourceRange.layerCount = 1;
+            barrier.subresourceRange.layerCount = layerCount;
 
             VkPipelineStageFlags sourceStage;
             VkPipelineStageFlags destinationStage;
@@ -384,8 +677,6 @@ namespace Fox {
                 0, nullptr,
                 1, &barrier
             );
-
-            EndSingleTimeCommands(commandBuffer);
         }
 
         VkShaderModule createShaderModule(const std::vector<char>& code) {
@@ -432,6 +723,36 @@ namespace Fox {
             if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
                 throw std::runtime_error("failed to allocate command buffers!");
             }
+
+            // one context per thread that can record, with a pool per frame in flight that is reset once the frame's fence has signalled
+            QueueFamilyIndices queueFamilyIndices = FindQueueFamilies(physicalDevice);
+            recordingContexts.resize(threadPool->GetThreadCount() + 1u);
+
+            for (RecordingContext& context : recordingContexts) {
+                context.commandPools.resize(MAX_FRAMES_IN_FLIGHT);
+                context.commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+
+                for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+                    VkCommandPoolCreateInfo poolInfo{};
+                    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                    poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+
+                    if (vkCreateCommandPool(device, &poolInfo, nullptr, &context.commandPools[i]) != VK_SUCCESS) {
+                        throw std::runtime_error("Failed to create recording command pool!");
+                    }
+
+                    VkCommandBufferAllocateInfo secondaryInfo{};
+                    secondaryInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                    secondaryInfo.commandPool = context.commandPools[i];
+                    secondaryInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+                    secondaryInfo.commandBufferCount = 1;
+
+                    if (vkAllocateCommandBuffers(device, &secondaryInfo, &context.commandBuffers[i]) != VK_SUCCESS) {
+                        throw std::runtime_error("failed to allocate secondary command buffers!");
+                    }
+                }
+            }
         }
 
         
@@ -457,8 +778,7 @@ namespace Fox {
             VkPhysicalDeviceFeatures supportedFeatures;
             vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
-            return deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU &&
-                deviceFeatures.geometryShader && indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+            return deviceFeatures.geometryShader && indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
         }
 
         void Renderer::CreateLogicalDevice() {
@@ -467,6 +787,13 @@ namespace Fox {
             std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
             std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
 
+            graphicsQueueFamily = indices.graphicsFamily.value();
+            transferQueueFamily = graphicsQueueFamily;
+            if (config.useTransferQueue && indices.transferFamily.has_value()) {
+                transferQueueFamily = indices.transferFamily.value();
+                uniqueQueueFamilies.insert(transferQueueFamily);
+            }
+
             float queuePriority = 1.0f;
             for (uint32_t queueFamily : uniqueQueueFamilies) {
                 VkDeviceQueueCreateInfo queueCreateInfo{};
@@ -477,22 +804,54 @@ namespace Fox {
                 queueCreateInfos.push_back(queueCreateInfo);
             }
 
+            VkPhysicalDeviceFeatures supportedFeatures;
+            vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
             VkPhysicalDeviceFeatures deviceFeatures{};
             deviceFeatures.samplerAnisotropy = VK_TRUE;
             deviceFeatures.sampleRateShading = VK_TRUE; // enable sample shading feature for the device
             deviceFeatures.fillModeNonSolid = VK_TRUE;
             deviceFeatures.wideLines = VK_TRUE;
+            deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+
+            // indirect draws carry the first instance of every draw, which picks its instances and draw data
+            indirectDrawsSupported = config.useIndirectDraws && supportedFeatures.multiDrawIndirect && supportedFeatures.drawIndirectFirstInstance;
+            if (indirectDrawsSupported) {
+                deviceFeatures.multiDrawIndirect = VK_TRUE;
+                deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
+            } else if (config.useIndirectDraws) {
+                std::cout << "Warning: multi draw indirect is not supported, draws are recorded one by one." << std::endl;
+            }
+            enabledFeatures = deviceFeatures;
+
+            std::vector<const char*> enabledExtensions = deviceExtensions;
+
+            VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+            indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+            bindlessSupported = config.useBindless && CheckBindlessSupport(indexingFeatures);
+            if (bindlessSupported) {
+                enabledExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+            } else if (config.useBindless) {
+                std::cout << "Warning: descriptor indexing is not supported, textures are bound with one descriptor set each." << std::endl;
+            }
+
+            // the budget query goes through vkGetPhysicalDeviceMemoryProperties2
+            memoryBudgetSupported = apiVersion >= VK_API_VERSION_1_1 && CheckDeviceExtensionSupport(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            if (memoryBudgetSupported) {
+                enabledExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
 
             VkDeviceCreateInfo createInfo{};
             createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+            createInfo.pNext = bindlessSupported ? &indexingFeatures : nullptr;
 
             createInfo.pQueueCreateInfos = queueCreateInfos.data();
             createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 
             createInfo.pEnabledFeatures = &deviceFeatures;
 
-            createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-            createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+            createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+            createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
             if (enableValidationLayers) {
                 createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -509,6 +868,64 @@ namespace Fox {
 
             vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
             vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &presentQueue);
+            vkGetDeviceQueue(device, transferQueueFamily, 0, &transferQueue);
+
+            if (indirectDrawsSupported) {
+                VkPhysicalDeviceProperties properties;
+                vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+                maxDrawIndirectCount = std::max(properties.limits.maxDrawIndirectCount, 1u);
+            }
+
+            if (!HasDedicatedTransferQueue()) {
+                std::cout << "Warning: no dedicated transfer queue, streaming uploads use the graphics queue." << std::endl;
+            }
+        }
+
+        bool Renderer::CheckBindlessSupport(VkPhysicalDeviceDescriptorIndexingFeaturesEXT& indexingFeatures) {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+            if (apiVersion < VK_API_VERSION_1_1 || properties.apiVersion < VK_API_VERSION_1_1) {
+                return false;
+            }
+
+            if (!CheckDeviceExtensionSupport(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+                return false;
+            }
+
+            VkPhysicalDeviceDescriptorIndexingFeaturesEXT supported{};
+            supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+            VkPhysicalDeviceFeatures2 features{};
+            features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features.pNext = &supported;
+            vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+            if (!supported.runtimeDescriptorArray || !supported.descriptorBindingPartiallyBound || !supported.descriptorBindingUpdateUnusedWhilePending ||
+                !supported.descriptorBindingSampledImageUpdateAfterBind || !supported.descriptorBindingStorageBufferUpdateAfterBind ||
+                !supported.shaderSampledImageArrayNonUniformIndexing) {
+                return false;
+            }
+
+            // only what the bindless tables use is enabled
+            indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+            indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+            indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+            indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+            indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+            indexingFeatures.shaderStorageBufferArrayNonUniformIndexing = supported.shaderStorageBufferArrayNonUniformIndexing;
+            return true;
+        }
+
+        bool Renderer::CheckDeviceExtensionSupport(const char* extensionName) {
+            uint32_t extensionCount;
+            vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+            std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+            vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+
+            return std::any_of(availableExtensions.begin(), availableExtensions.end(), [extensionName](const VkExtensionProperties& extension) {
+                return strcmp(extension.extensionName, extensionName) == 0;
+            });
         }
 
         void Renderer::PickPhysicalDevice() {
@@ -521,18 +938,36 @@ namespace Fox {
             std::vector<VkPhysicalDevice> devices(deviceCount);
             vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
+            // prefer a discrete GPU but accept integrated and software devices such as lavapipe
+            VkPhysicalDevice fallbackDevice = VK_NULL_HANDLE;
             for (const VkPhysicalDevice& device : devices) {
-                if (IsDeviceSuitable(device)) {
+                if (!IsDeviceSuitable(device)) {
+                    continue;
+                }
+
+                VkPhysicalDeviceProperties deviceProperties;
+                vkGetPhysicalDeviceProperties(device, &deviceProperties);
+
+                if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
                     physicalDevice = device;
-                    config.msaaSamples = GetMaxUsableSampleCount();
                     break;
                 }
+
+                if (fallbackDevice == VK_NULL_HANDLE) {
+                    fallbackDevice = device;
+                }
+            }
+
+            if (physicalDevice == VK_NULL_HANDLE) {
+                physicalDevice = fallbackDevice;
             }
 
             if (physicalDevice == VK_NULL_HANDLE) {
                 throw std::runtime_error("failed to find a suitable GPU!");
             }
 
+            config.msaaSamples = GetMaxUsableSampleCount();
+
         }
 
         bool Renderer::CheckDeviceExtensionSupport(VkPhysicalDevice device) {
@@ -562,26 +997,33 @@ namespace Fox {
             std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
             vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
+            bool transferOnly = false;
+
             int i = 0;
             for (const auto& queueFamily : queueFamilies) {
 
-                if (indices.isComplete()) {
-                    break;
-                }
-
                 VkBool32 presentSupport = false;
 
                 if (surface) {
                     vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
                 }
 
-                if (presentSupport) {
+                if (presentSupport && !indices.presentFamily.has_value()) {
                     indices.presentFamily = i;
                 }
 
-                if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+                if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphicsFamily.has_value()) {
                     indices.graphicsFamily = i;
                 }
+
+                // prefer a transfer-only family (DMA engine), otherwise any non-graphics family since compute queues can copy too
+                if (!(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && (queueFamily.queueFlags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                    bool familyTransferOnly = !(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT);
+                    if (!indices.transferFamily.has_value() || (familyTransferOnly && !transferOnly)) {
+                        indices.transferFamily = i;
+                        transferOnly = familyTransferOnly;
+                    }
+                }
                 i++;
             }
 
@@ -594,7 +1036,14 @@ namespace Fox {
             applicationInfo.pApplicationName = "Fox Engine";
             applicationInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
             applicationInfo.pEngineName = "No Engine";
-            applicationInfo.apiVersion = VK_API_VERSION_1_0;
+            // descriptor indexing needs 1.1 for vkGetPhysicalDeviceFeatures2, a 1.0 loader does not know vkEnumerateInstanceVersion
+            PFN_vkEnumerateInstanceVersion enumerateInstanceVersion = reinterpret_cast<PFN_vkEnumerateInstanceVersion>(vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion"));
+            uint32_t instanceVersion = VK_API_VERSION_1_0;
+            if (enumerateInstanceVersion) {
+                enumerateInstanceVersion(&instanceVersion);
+            }
+            apiVersion = instanceVersion >= VK_API_VERSION_1_1 ? VK_API_VERSION_1_1 : VK_API_VERSION_1_0;
+            applicationInfo.apiVersion = apiVersion;
 
             VkInstanceCreateInfo createInfo = {};
             createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -725,12 +1174,12 @@ namespace Fox {
             }
         }
 
-		void Renderer::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
+		void Renderer::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset) {
 			VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
 
 			VkBufferCopy copyRegion{};
-			copyRegion.srcOffset = 0; // Optional
-			copyRegion.dstOffset = 0; // Optional
+			copyRegion.srcOffset = srcOffset;
+			copyRegion.dstOffset = dstOffset;
 			copyRegion.size = size;
 			vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
@@ -769,6 +1218,23 @@ namespace Fox {
             EndSingleTimeCommands(commandBuffer);
         }
 
+        void Renderer::CopyBufferToImage(VkBuffer buffer, VkImage image, const std::vector<VkBufferImageCopy>& regions) {
+            VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
+            CopyBufferToImage(commandBuffer, buffer, image, regions);
+            EndSingleTimeCommands(commandBuffer);
+        }
+
+        void Renderer::CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkImage image, const std::vector<VkBufferImageCopy>& regions) {
+            vkCmdCopyBufferToImage(
+                commandBuffer,
+                buffer,
+                image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                static_cast<uint32_t>(regions.size()),
+                regions.data()
+            );
+        }
+
         VkCommandBuffer Renderer::BeginSingleTimeCommands() {
 
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
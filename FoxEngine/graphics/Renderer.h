@@ -18,10 +18,13 @@ namespace Fox {
 		class RenderPassManager;
 		class SceneGraph;
 		class SceneNode;
+		class StreamingManager;
+		class MeshCache;
 
 		struct QueueFamilyIndices {
 			std::optional<uint32_t> graphicsFamily;
 			std::optional<uint32_t> presentFamily;
+			std::optional<uint32_t> transferFamily;
 
 			bool isComplete() {
 				return graphicsFamily.has_value() && presentFamily.has_value();
@@ -33,9 +36,30 @@ namespace Fox {
 			glm::mat4 matrix;
 		};
 
+		// every batch of a model drawn with one instanced draw, its transforms are instances [firstInstance, firstInstance + instanceCount)
+		// of the frame's instance buffer
+		struct InstancedBatch {
+			Fox::Vulkan::Model* model;
+			uint32_t firstInstance = 0u;
+			uint32_t instanceCount = 0u;
+			uint32_t textureIndex = 0u;	// slot in the bindless texture table
+			float depth = std::numeric_limits<float>::max();	// view space distance of the nearest instance
+		};
+
+		// everything a draw needs resolved on the main thread, so that recording it touches no shared state
+		struct DrawCommand {
+			const Fox::Vulkan::InstancedBatch* batch = nullptr;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+			std::array<uint32_t, 3> dynamicOffsets = { 0u, 0u, 0u };	// per-object slot, instance buffer, draw data
+			Fox::Vulkan::PerObjectConstantBuffer perObject{};
+		};
+
 		template<class T>
 		class Buffer;
 
+		template<class V, class I>
+		class GeometryPool;
+
 		class Renderer {
 
 			public:
@@ -60,13 +84,21 @@ namespace Fox {
 				void RenderBegin(VkCommandBuffer commandBuffer);
 				void RenderEnd(VkCommandBuffer commandBuffer);
 				void DrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
-				void SetDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* descriptorSets);
+				void SetDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* descriptorSets,
+					uint32_t dynamicOffsetCount = 0u, const uint32_t* dynamicOffsets = nullptr);
+				// pushes to the ranges the current pipeline declares, false when none of them covers the bytes
+				bool PushConstants(VkCommandBuffer commandBuffer, uint32_t offset, uint32_t size, const void* data);
+				template<class T>
+				bool PushConstants(VkCommandBuffer commandBuffer, const T& data, uint32_t offset = 0u) {
+					return PushConstants(commandBuffer, offset, static_cast<uint32_t>(sizeof(T)), &data);
+				}
 				void SetIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer indexBuffer, VkDeviceSize offset, VkIndexType type);
 				void SetVertexBuffers(VkCommandBuffer commandBuffer, std::vector<VkBuffer>& vertexBuffers, uint32_t firstBinding, const VkDeviceSize* offsets);
 				void SetScissor(VkCommandBuffer commandBuffer, VkOffset2D offset, VkExtent2D extent);
 				void SetViewport(VkCommandBuffer commandBuffer, float topleftX, float topleftY, float width, float height, float minDepth, float maxDepth);
 				void SetGraphicsPipeline(VkCommandBuffer commandBuffer, VkPipeline pipeline);
-				void RenderPassBegin(VkCommandBuffer commandBuffer, VkClearColorValue clearColor, float clearDepth, uint32_t clearStencil, VkRenderPass renderPass, VkFramebuffer framebuffer, VkOffset2D renderAreaOffset, VkExtent2D renderArea);
+				void RenderPassBegin(VkCommandBuffer commandBuffer, VkClearColorValue clearColor, float clearDepth, uint32_t clearStencil, VkRenderPass renderPass, VkFramebuffer framebuffer, VkOffset2D renderAreaOffset, VkExtent2D renderArea,
+					VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 				void RenderPassEnd(VkCommandBuffer);
 
 				uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
@@ -82,8 +114,10 @@ namespace Fox {
 					throw std::runtime_error("Failed to find suitable memory type!");
 				}
 
-				void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+				void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0);
 				void CopyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+				void CopyBufferToImage(VkBuffer buffer, VkImage image, const std::vector<VkBufferImageCopy>& regions);
+				void CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkImage image, const std::vector<VkBufferImageCopy>& regions);
 
 				VkCommandBuffer BeginSingleTimeCommands();
 				void EndSingleTimeCommands(VkCommandBuffer commandBuffer);
@@ -117,6 +151,8 @@ namespace Fox {
 				bool IsDeviceSuitable(VkPhysicalDevice device);
 				void PickPhysicalDevice();
 				void CreateLogicalDevice();
+				bool CheckBindlessSupport(VkPhysicalDeviceDescriptorIndexingFeaturesEXT& indexingFeatures);
+				bool CheckDeviceExtensionSupport(const char* extensionName);
 
 
 				void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
@@ -126,7 +162,10 @@ namespace Fox {
 				VkFormat FindSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 				VkFormat FindDepthFormat();
 				bool HasStencilComponent(VkFormat format);				
-				void TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels);
+				void TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount = 1u);
+				// records the barrier into a command buffer the caller submits, e.g. together with the copy it guards
+				void TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels,
+					uint32_t layerCount = 1u);
 
 				void ResizeWindow(int width, int height) {
 					if (screenWidth != width || screenHeight != height) {
@@ -140,6 +179,10 @@ namespace Fox {
 
 				void LoadModel();
 
+				inline uint64_t GetFrameNumber() const {
+					return frameNumber;
+				}
+
 				Fox::Vulkan::RendererConfig& GetConfig() {
 					return config;
 				}
@@ -160,10 +203,85 @@ namespace Fox {
 					return descriptorManager.get();
 				}
 
+				inline Fox::Vulkan::GraphicsPipelineStateManager* GetGraphicsPipelineStateManager() {
+					return graphicsPipelineState.get();
+				}
+
 				inline Fox::Vulkan::RenderPassManager* GetRenderPassManager() {
 					return renderPassManager.get();
 				}
 
+				inline Fox::Vulkan::GeometryPool<Fox::Vulkan::Vertex, uint32_t>* GetGeometryPool() {
+					return geometryPool.get();
+				}
+
+				inline Fox::Core::ThreadPool* GetThreadPool() {
+					return threadPool.get();
+				}
+
+				inline const VkPhysicalDeviceFeatures& GetEnabledFeatures() const {
+					return enabledFeatures;
+				}
+
+				inline Fox::Vulkan::MeshCache* GetMeshCache() {
+					return meshCache.get();
+				}
+
+				inline Fox::Vulkan::StreamingManager* GetStreamingManager() {
+					return streamingManager.get();
+				}
+
+				inline VkQueue GetGraphicsQueue() {
+					return graphicsQueue;
+				}
+
+				inline VkQueue GetTransferQueue() {
+					return transferQueue;
+				}
+
+				inline uint32_t GetGraphicsQueueFamily() {
+					return graphicsQueueFamily;
+				}
+
+				inline uint32_t GetTransferQueueFamily() {
+					return transferQueueFamily;
+				}
+
+				inline bool HasDedicatedTransferQueue() {
+					return graphicsQueueFamily != transferQueueFamily;
+				}
+
+				inline uint32_t GetApiVersion() const {
+					return apiVersion;
+				}
+
+				inline Fox::Vulkan::MemoryAllocator* GetMemoryAllocator() {
+					return memoryAllocator.get();
+				}
+
+				inline Fox::Vulkan::UploadRing* GetUploadRing() {
+					return uploadRing.get();
+				}
+
+				inline Fox::Vulkan::StagingPool* GetStagingPool() {
+					return stagingPool.get();
+				}
+
+				// descriptor indexing was found and enabled on the device
+				inline bool SupportsBindless() const {
+					return bindlessSupported;
+				}
+
+				// VK_EXT_memory_budget was found and enabled on the device
+				inline bool SupportsMemoryBudget() const {
+					return memoryBudgetSupported;
+				}
+
+				// multiDrawIndirect and drawIndirectFirstInstance were found and enabled on the device
+				inline bool SupportsIndirectDraws() const {
+					return indirectDrawsSupported;
+				}
+
 				VkSurfaceKHR surface;
 				VkInstance instance;
 				std::shared_ptr<Fox::Vulkan::SceneGraph> sceneGraph;
@@ -173,6 +291,15 @@ namespace Fox {
 
 
 				std::vector<Fox::Vulkan::Batch> batches;
+
+				inline uint32_t GetDrawCallCount() const {
+					return drawCalls;
+				}
+
+				// draws of the last frame that were skipped because their per-object data found no room in the upload ring
+				inline uint32_t GetDroppedDrawCount() const {
+					return droppedDraws;
+				}
 				
 		private:
 
@@ -185,8 +312,25 @@ namespace Fox {
 			VkResult CreateDebugUtilsMessengerEXT(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDebugUtilsMessengerEXT* pDebugMessenger);
 			void SetupDebugMessenger();
 			void DestroyDebugUtilsMessengerEXT(VkInstance instance, VkDebugUtilsMessengerEXT debugMessenger, const VkAllocationCallbacks* pAllocator);
+			// groups the batches by model and writes their transforms to the upload ring, false when it is full
+			bool BuildInstancedBatches();
+			// fills the render queue with the instanced batches, recording follows its order
+			void SortInstancedBatches();
+			// resolves descriptor sets, texture slots and per-object data of the sorted draws
+			void PrepareDraws();
+			// records draws [begin, end) including the state they need, safe to call from several threads at once
+			void RecordDraws(VkCommandBuffer commandBuffer, size_t begin, size_t end);
+			// all of the frame's draws from the indirect commands PrepareDraws wrote
+			void RecordIndirectDraws(VkCommandBuffer commandBuffer, const Fox::Vulkan::DrawCommand& draw);
+
+			// secondary command buffers of one recorded chunk of draws
+			struct RecordingContext {
+				std::vector<VkCommandPool> commandPools;		// per frame in flight
+				std::vector<VkCommandBuffer> commandBuffers;
+			};
 		
 			const std::string MODEL_PATH = "models/viking.obj";
+			const std::string TEXTURE_PATH = "textures/viking.png";
 
 #ifdef NDEBUG
 			const bool enableValidationLayers = false;
@@ -210,6 +354,15 @@ namespace Fox {
 
 			VkCommandPool commandPool;
 			VkQueue graphicsQueue;
+			VkQueue transferQueue;
+			uint32_t graphicsQueueFamily = 0u;
+			uint32_t transferQueueFamily = 0u;
+			VkPhysicalDeviceFeatures enabledFeatures{};
+			uint32_t apiVersion = VK_API_VERSION_1_0;
+			bool bindlessSupported = false;
+			bool memoryBudgetSupported = false;
+			bool indirectDrawsSupported = false;
+			uint32_t maxDrawIndirectCount = 1u;
 
 
 			VkDebugUtilsMessengerEXT debugMessenger;
@@ -219,9 +372,27 @@ namespace Fox {
 			std::vector<VkCommandBuffer> commandBuffers; // cleaned with pool automatically
 
 			uint32_t currentFrame = 0u;
+			uint64_t frameNumber = 0u;
 
 			uint32_t mipLevels;
 
+			std::vector<Fox::Vulkan::InstancedBatch> instancedBatches;
+			std::unordered_map<Fox::Vulkan::Model*, uint32_t> instancedBatchIndices;
+			uint32_t instanceOffset = 0u;	// dynamic offset of the frame's instance buffer and draw data
+			Fox::Vulkan::PerObjectConstantBuffer* drawData = nullptr;	// per instanced batch, written for indirect pipelines
+			uint32_t firstDrawIndex = 0u;
+
+			// the frame's draws as VkDrawIndexedIndirectCommand in the upload ring, zero draws records them one by one
+			struct IndirectDraws {
+				VkDeviceSize commandOffset = 0u;
+				uint32_t drawCount = 0u;
+			} indirectDraws;
+			Fox::Vulkan::RenderQueue renderQueue;
+			std::vector<Fox::Vulkan::DrawCommand> drawCommands;
+			std::vector<RecordingContext> recordingContexts;
+			uint32_t drawCalls = 0u;
+			uint32_t droppedDraws = 0u;
+
 			bool frameBufferResized = false;
 			uint32_t screenWidth = ~0u; 
 			uint32_t screenHeight = ~0u;
@@ -230,14 +401,21 @@ namespace Fox {
 
 			Fox::Vulkan::RendererConfig config;
 
+			std::unique_ptr<Fox::Core::ThreadPool> threadPool;
+			std::unique_ptr<Fox::Vulkan::MemoryAllocator> memoryAllocator;
+			std::unique_ptr<Fox::Vulkan::StagingPool> stagingPool;
 			std::unique_ptr<Fox::Vulkan::DescriptorSetManager> descriptorManager;
 			std::unique_ptr<Fox::Vulkan::SamplerManager> samplerManager;
 			std::unique_ptr<Fox::Vulkan::TextureManager> textureManager;
 			std::unique_ptr<Fox::Vulkan::RenderPassManager> renderPassManager;
 			std::unique_ptr<Fox::Vulkan::GraphicsPipelineStateManager> graphicsPipelineState;
 			std::unique_ptr<Fox::Vulkan::ConstantBuffers> constantBuffers;
+			std::unique_ptr<Fox::Vulkan::UploadRing> uploadRing;
 			std::unique_ptr<Fox::Vulkan::Swapchain> swapchain;
 			std::unique_ptr<Fox::Vulkan::Synchronization> synchronization;
+			std::unique_ptr<Fox::Vulkan::GeometryPool<Fox::Vulkan::Vertex, uint32_t>> geometryPool;
+			std::unique_ptr<Fox::Vulkan::MeshCache> meshCache;
+			std::unique_ptr<Fox::Vulkan::StreamingManager> streamingManager;
 
 	//		std::shared_ptr<Fox::Vulkan::Model> model;
 		};
@@ -7,6 +7,30 @@ namespace Fox {
 		struct RendererConfig {
 			void* windowHandle;
 			VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
+			uint32_t maxPooledVertices = 1u << 20u;
+			uint32_t maxPooledIndices = 1u << 22u;
+			bool useTransferQueue = true;
+			uint32_t workerThreads = 0u;
+			uint32_t maxTextures = 256u;
+			bool textureStreaming = true;
+			uint64_t textureBudget = 256ull << 20u;
+			uint32_t textureTailSize = 128u;	// levels this size or smaller never leave
+			uint32_t textureUploadsPerFrame = 4u;
+			uint64_t importStagingSize = 64ull << 20u;	// staging ring shared by a bulk texture import
+			uint32_t atlasPageSize = 2048u;
+			uint32_t atlasPadding = 8u;		// gutter around every packed texture, rounded down to a power of two
+			bool useBindless = true;		// falls back to a descriptor set per texture without descriptor indexing
+			uint32_t maxBindlessTextures = 4096u;
+			uint32_t maxBindlessBuffers = 1024u;
+			uint64_t memoryBlockSize = 64ull << 20u;	// device memory is sub-allocated from blocks of this size
+			uint64_t uploadRingSize = 4ull << 20u;		// transient data per frame in flight
+			uint64_t stagingBlockSize = 32ull << 20u;	// uploads larger than this get a temporary buffer
+			uint32_t maxStagingBlocks = 4u;
+			uint64_t defragmentBytesPerFrame = 8ull << 20u;	// textures moved out of sparse memory blocks per frame, 0 disables it
+			bool useIndirectDraws = true;	// needs multiDrawIndirect and drawIndirectFirstInstance
+			uint32_t parallelRecordingThreshold = 2048u;	// frames with fewer draws are recorded on the main thread
+			uint32_t memoryReportInterval = 0u;		// frames between memory report dumps, 0 disables them
+			std::string memoryReportPath = "memory_report.json";
 
 		};
 	}
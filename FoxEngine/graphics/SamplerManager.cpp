@@ -3,49 +3,228 @@
 namespace Fox {
 
 	namespace Vulkan {
-	
+
+        static void HashCombine(size_t& seed, size_t value) {
+            seed ^= value + 0x9e3779b9u + (seed << 6u) + (seed >> 2u);
+        }
+
+        size_t SamplerDescriptionHash::operator()(const Fox::Vulkan::SamplerDescription& description) const {
+            size_t seed = 0u;
+            HashCombine(seed, std::hash<int32_t>()(description.magFilter));
+            HashCombine(seed, std::hash<int32_t>()(description.minFilter));
+            HashCombine(seed, std::hash<int32_t>()(description.mipmapMode));
+            HashCombine(seed, std::hash<int32_t>()(description.addressModeU));
+            HashCombine(seed, std::hash<int32_t>()(description.addressModeV));
+            HashCombine(seed, std::hash<int32_t>()(description.addressModeW));
+            HashCombine(seed, std::hash<float>()(description.mipLodBias));
+            HashCombine(seed, std::hash<bool>()(description.anisotropyEnable));
+            HashCombine(seed, std::hash<float>()(description.maxAnisotropy));
+            HashCombine(seed, std::hash<bool>()(description.compareEnable));
+            HashCombine(seed, std::hash<int32_t>()(description.compareOp));
+            HashCombine(seed, std::hash<float>()(description.minLod));
+            HashCombine(seed, std::hash<float>()(description.maxLod));
+            HashCombine(seed, std::hash<int32_t>()(description.borderColor));
+            HashCombine(seed, std::hash<bool>()(description.unnormalizedCoordinates));
+            return seed;
+        }
+
 		SamplerManager::SamplerManager(uint32_t maxMipLevels) : maxMipLevels(maxMipLevels)
         {}
 
 		SamplerManager::~SamplerManager() {
 			VkDevice device = Fox::Vulkan::Renderer::GetDevice();
-			vkDestroySampler(device, textureSampler, nullptr);
+            for (auto& sampler : samplers) {
+                vkDestroySampler(device, sampler.second, nullptr);
+            }
+            samplers.clear();
 		}
 
 		void SamplerManager::CreateSamplers() {
-            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
             Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
 
             VkPhysicalDeviceProperties properties{};
             vkGetPhysicalDeviceProperties(renderer->physicalDevice, &properties);
 
+            maxSamplerCount = properties.limits.maxSamplerAllocationCount;
+            maxAnisotropy = properties.limits.maxSamplerAnisotropy;
+
+            textureSampler = VK_NULL_HANDLE;
+            textureSampler = GetSampler(Fox::Vulkan::SamplerDescription());
+		}
+
+        Fox::Vulkan::SamplerDescription SamplerManager::Normalize(const Fox::Vulkan::SamplerDescription& description) const {
+            Fox::Vulkan::SamplerDescription normalized = description;
+
+            normalized.maxAnisotropy = normalized.anisotropyEnable ? std::clamp(normalized.maxAnisotropy, 1.0f, maxAnisotropy) : 1.0f;
+            normalized.anisotropyEnable = normalized.anisotropyEnable && normalized.maxAnisotropy > 1.0f;
+
+            if (!normalized.compareEnable) {
+                normalized.compareOp = VK_COMPARE_OP_ALWAYS;
+            }
+
+            normalized.maxLod = std::min(normalized.maxLod, static_cast<float>(maxMipLevels));
+            normalized.minLod = std::min(normalized.minLod, normalized.maxLod);
+
+            // the border colour only matters when an address mode clamps to it
+            bool usesBorder = normalized.addressModeU == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER ||
+                normalized.addressModeV == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER ||
+                normalized.addressModeW == VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+            if (!usesBorder) {
+                normalized.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+            }
+
+            return normalized;
+        }
+
+        VkSampler SamplerManager::GetSampler(const Fox::Vulkan::SamplerDescription& description) {
+            Fox::Vulkan::SamplerDescription key = Normalize(description);
+
+            auto it = samplers.find(key);
+            if (it != samplers.end()) {
+                return it->second;
+            }
+
+            if (samplers.size() >= maxSamplerCount && textureSampler != VK_NULL_HANDLE) {
+                std::cout << "Warning: sampler limit of " << maxSamplerCount << " reached, using the default sampler." << std::endl;
+                return textureSampler;
+            }
+
             VkSamplerCreateInfo samplerInfo{};
             samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-            samplerInfo.magFilter = VK_FILTER_LINEAR;
-            samplerInfo.minFilter = VK_FILTER_LINEAR;
-            samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-            samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-            samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+            samplerInfo.magFilter = key.magFilter;
+            samplerInfo.minFilter = key.minFilter;
+            samplerInfo.addressModeU = key.addressModeU;
+            samplerInfo.addressModeV = key.addressModeV;
+            samplerInfo.addressModeW = key.addressModeW;
 
-            samplerInfo.anisotropyEnable = VK_TRUE;
-            samplerInfo.maxAnisotropy = properties.limits.maxSamplerAnisotropy;
+            samplerInfo.anisotropyEnable = key.anisotropyEnable ? VK_TRUE : VK_FALSE;
+            samplerInfo.maxAnisotropy = key.maxAnisotropy;
 
-            samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-            samplerInfo.unnormalizedCoordinates = VK_FALSE;
+            samplerInfo.borderColor = key.borderColor;
+            samplerInfo.unnormalizedCoordinates = key.unnormalizedCoordinates ? VK_TRUE : VK_FALSE;
 
-            samplerInfo.compareEnable = VK_FALSE;
-            samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+            samplerInfo.compareEnable = key.compareEnable ? VK_TRUE : VK_FALSE;
+            samplerInfo.compareOp = key.compareOp;
 
-            samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-            samplerInfo.mipLodBias = 0.0f;
-            samplerInfo.minLod = 0.0f;
-            samplerInfo.maxLod = static_cast<float>(maxMipLevels);
+            samplerInfo.mipmapMode = key.mipmapMode;
+            samplerInfo.mipLodBias = key.mipLodBias;
+            samplerInfo.minLod = key.minLod;
+            samplerInfo.maxLod = key.maxLod;
 
-            if (vkCreateSampler(device, &samplerInfo, nullptr, &textureSampler) != VK_SUCCESS) {
+            VkSampler sampler;
+            if (vkCreateSampler(Fox::Vulkan::Renderer::GetDevice(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create texture sampler!");
             }
-		}
 
+            samplers.emplace(key, sampler);
+            return sampler;
+        }
+
+        Fox::Vulkan::SamplerDescription SamplerManager::ReadDescription(Fox::Core::Json::JSONObject& object) {
+            Fox::Vulkan::SamplerDescription description;
+
+            auto readString = [&object](const char* key, std::string& value) {
+                if (object.Has(key)) {
+                    value = object.Get<Fox::Core::Json::StringValue>(key).GetValue();
+                    return true;
+                }
+                return false;
+            };
 
+            // numbers written without a fraction are parsed as integers
+            auto readFloat = [&object](const char* key, float& value) {
+                if (!object.Has(key)) {
+                    return;
+                }
+                std::string name(key);
+                Fox::Core::Json::JSONValue* number = &object[name];
+                if (Fox::Core::Json::FloatValue* floatValue = dynamic_cast<Fox::Core::Json::FloatValue*>(number)) {
+                    value = floatValue->GetValue();
+                } else if (Fox::Core::Json::IntValue* intValue = dynamic_cast<Fox::Core::Json::IntValue*>(number)) {
+                    value = static_cast<float>(intValue->GetValue());
+                }
+            };
+
+            auto readBool = [&object](const char* key, bool& value) {
+                if (object.Has(key)) {
+                    value = object.Get<Fox::Core::Json::BoolValue>(key).GetValue();
+                }
+            };
+
+            std::string value;
+            if (readString("magFilter", value)) {
+                description.magFilter = GetFilter(value);
+            }
+            if (readString("minFilter", value)) {
+                description.minFilter = GetFilter(value);
+            }
+            if (readString("mipmapMode", value)) {
+                description.mipmapMode = GetMipmapMode(value);
+            }
+            if (readString("addressModeU", value)) {
+                description.addressModeU = GetAddressMode(value);
+            }
+            if (readString("addressModeV", value)) {
+                description.addressModeV = GetAddressMode(value);
+            }
+            if (readString("addressModeW", value)) {
+                description.addressModeW = GetAddressMode(value);
+            }
+            if (readString("compareOp", value)) {
+                description.compareOp = GetCompareOp(value);
+            }
+            if (readString("borderColor", value)) {
+                description.borderColor = GetBorderColor(value);
+            }
+
+            readFloat("mipLodBias", description.mipLodBias);
+            readFloat("maxAnisotropy", description.maxAnisotropy);
+            readFloat("minLod", description.minLod);
+            readFloat("maxLod", description.maxLod);
+
+            readBool("anisotropyEnable", description.anisotropyEnable);
+            readBool("compareEnable", description.compareEnable);
+            readBool("unnormalizedCoordinates", description.unnormalizedCoordinates);
+
+            return description;
+        }
+
+        VkFilter SamplerManager::GetFilter(const std::string& filter) {
+            if (filter == "nearest") {
+                return VK_FILTER_NEAREST;
+            }
+            return VK_FILTER_LINEAR;
+        }
+
+        VkSamplerMipmapMode SamplerManager::GetMipmapMode(const std::string& mipmapMode) {
+            if (mipmapMode == "nearest") {
+                return VK_SAMPLER_MIPMAP_MODE_NEAREST;
+            }
+            return VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        }
+
+        VkSamplerAddressMode SamplerManager::GetAddressMode(const std::string& addressMode) {
+            if (addressMode == "mirrored_repeat") {
+                return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+            } else if (addressMode == "clamp_to_edge") {
+                return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+            } else if (addressMode == "clamp_to_border") {
+                return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+            }
+            return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        }
+
+        VkCompareOp SamplerManager::GetCompareOp(const std::string& compareOp) {
+            return Fox::Vulkan::GraphicsPipelineState::GetVulkanCompareOp(Fox::Vulkan::PipelineConfig::GetCompareOperation(compareOp));
+        }
+
+        VkBorderColor SamplerManager::GetBorderColor(const std::string& borderColor) {
+            if (borderColor == "transparent_black") {
+                return VK_BORDER_COLOR_INT_TRANSPARENT_BLACK;
+            } else if (borderColor == "opaque_white") {
+                return VK_BORDER_COLOR_INT_OPAQUE_WHITE;
+            }
+            return VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+        }
 	}
-}
\ No newline at end of file
+}
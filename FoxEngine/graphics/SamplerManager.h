@@ -4,6 +4,34 @@ namespace Fox {
 
 	namespace Vulkan {
 
+		// everything that goes into a VkSamplerCreateInfo, equal descriptions share one sampler
+		struct SamplerDescription {
+			VkFilter magFilter = VK_FILTER_LINEAR;
+			VkFilter minFilter = VK_FILTER_LINEAR;
+			VkSamplerMipmapMode mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+			VkSamplerAddressMode addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+			VkSamplerAddressMode addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+			VkSamplerAddressMode addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+			float mipLodBias = 0.0f;
+			bool anisotropyEnable = true;
+			float maxAnisotropy = 16.0f;	// clamped to the device limit
+			bool compareEnable = false;
+			VkCompareOp compareOp = VK_COMPARE_OP_ALWAYS;
+			float minLod = 0.0f;
+			float maxLod = VK_LOD_CLAMP_NONE;	// clamped to the largest mip chain
+			VkBorderColor borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+			bool unnormalizedCoordinates = false;
+
+			bool operator==(const SamplerDescription& other) const = default;
+		};
+
+		struct SamplerDescriptionHash {
+			size_t operator()(const Fox::Vulkan::SamplerDescription& description) const;
+		};
+
+		// Sampler cache keyed by the full description. Samplers are created on first request and shared by everyone asking
+		// for the same description until the manager goes away. The device caps the number of samplers alive at once
+		// (maxSamplerAllocationCount), past it the default sampler is handed out instead.
 		class SamplerManager {
 		public:
 			SamplerManager() = default;
@@ -16,12 +44,35 @@ namespace Fox {
 				return textureSampler;
 			}
 
+			VkSampler GetSampler(const Fox::Vulkan::SamplerDescription& description);
+
+			inline uint32_t GetSamplerCount() const {
+				return static_cast<uint32_t>(samplers.size());
+			}
+
+			inline uint32_t GetMaxSamplerCount() const {
+				return maxSamplerCount;
+			}
+
+			// missing attributes keep their defaults
+			static Fox::Vulkan::SamplerDescription ReadDescription(Fox::Core::Json::JSONObject& object);
+			static VkFilter GetFilter(const std::string& filter);
+			static VkSamplerMipmapMode GetMipmapMode(const std::string& mipmapMode);
+			static VkSamplerAddressMode GetAddressMode(const std::string& addressMode);
+			static VkCompareOp GetCompareOp(const std::string& compareOp);
+			static VkBorderColor GetBorderColor(const std::string& borderColor);
+
 		private:
+			// brings equivalent descriptions to the same key, e.g. the anisotropy of a sampler that does not use it
+			Fox::Vulkan::SamplerDescription Normalize(const Fox::Vulkan::SamplerDescription& description) const;
+
 			uint32_t maxMipLevels;
+			uint32_t maxSamplerCount = 4000u;
+			float maxAnisotropy = 1.0f;
 			VkSampler textureSampler;
 
-			
+			std::unordered_map<Fox::Vulkan::SamplerDescription, VkSampler, Fox::Vulkan::SamplerDescriptionHash> samplers;
 		};
-	
+
 	}
-}
\ No newline at end of file
+}
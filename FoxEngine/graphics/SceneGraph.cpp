@@ -14,8 +14,8 @@ namespace Fox {
 		void SceneGraph::AddChild(std::string name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
 		}
 
-		std::shared_ptr<Fox::Vulkan::SceneNode>& SceneGraph::AddChild(std::string name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, std::string modelPath) {
-			return root->AddChild(name, position, rotation, scale, modelPath);
+		std::shared_ptr<Fox::Vulkan::SceneNode>& SceneGraph::AddChild(std::string name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, std::string modelPath, std::string texturePath) {
+			return root->AddChild(name, position, rotation, scale, modelPath, texturePath);
 		}
 
 		void SceneGraph::Update() {
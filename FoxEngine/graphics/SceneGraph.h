@@ -14,7 +14,7 @@ namespace Fox {
 			void Destroy();
 
 			void AddChild(std::string name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
-			std::shared_ptr<Fox::Vulkan::SceneNode>& AddChild(std::string name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, std::string modelPath);
+			std::shared_ptr<Fox::Vulkan::SceneNode>& AddChild(std::string name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, std::string modelPath, std::string texturePath = "");
 
 
 			void Update();
@@ -21,9 +21,9 @@ namespace Fox {
 			return node;
 		}
 
-		std::shared_ptr<Fox::Vulkan::SceneNode>& SceneNode::AddChild(std::string name, glm::vec3 position, glm::quat rotation, glm::vec3 scale, std::string modelPath) {
+		std::shared_ptr<Fox::Vulkan::SceneNode>& SceneNode::AddChild(std::string name, glm::vec3 position, glm::quat rotation, glm::vec3 scale, std::string modelPath, std::string texturePath) {
 			std::shared_ptr<Fox::Vulkan::ModelNode>& node = AddChild<Fox::Vulkan::ModelNode, Fox::Vulkan::SceneNode>(name, position, rotation, scale);
-			node->LoadModel(modelPath);
+			node->LoadModel(modelPath, texturePath);
 			return (std::shared_ptr<Fox::Vulkan::SceneNode>&) node;
 		}
 
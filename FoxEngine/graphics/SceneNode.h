@@ -23,9 +23,9 @@ namespace Fox {
 
 			template<class NodeType, class ParentType>
 			std::shared_ptr<NodeType>& AddChild(std::string name, glm::vec3 position, glm::quat rotation, glm::vec3 scale);
-			std::shared_ptr<Fox::Vulkan::SceneNode>& AddChild(std::string name, glm::vec3 position, glm::quat rotation, glm::vec3 scale, std::string modelPath);
+			std::shared_ptr<Fox::Vulkan::SceneNode>& AddChild(std::string name, glm::vec3 position, glm::quat rotation, glm::vec3 scale, std::string modelPath, std::string texturePath = "");
 			void UpdateLocalTransform();
-			void UpdateWorldTransform();
+			virtual void UpdateWorldTransform();
 
 			void SetRotation(float pitch, float yaw, float roll);
 			void SetPosition(float x, float y, float z);
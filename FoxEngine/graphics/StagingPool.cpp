@@ -0,0 +1,182 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		StagingPool::StagingPool(VkDeviceSize blockSize, uint32_t maxBlocks) : blockSize(blockSize), maxBlocks(std::max(maxBlocks, 1u)) {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(Fox::Vulkan::Renderer::GetRenderer()->physicalDevice, &properties);
+            copyAlignment = std::max<VkDeviceSize>(properties.limits.optimalBufferCopyOffsetAlignment, 16u);
+		}
+
+		StagingPool::~StagingPool() {
+            // whoever released with a fence has waited for its queue by now
+            for (PendingRelease& pending : pendingReleases) {
+                FreeLocked(pending.allocation);
+            }
+            pendingReleases.clear();
+
+            for (std::unique_ptr<Block>& block : blocks) {
+                if (!block->allocator.IsEmpty()) {
+                    std::cout << "Warning: " << block->allocator.GetStatistics().allocationCount << " staging regions still alive." << std::endl;
+                }
+            }
+            blocks.clear();
+		}
+
+        Fox::Vulkan::StagingAllocation StagingPool::Allocate(VkDeviceSize size, VkDeviceSize alignment) {
+            if (alignment == 0u) {
+                alignment = copyAlignment;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            statistics.requests++;
+
+            if (size > blockSize) {
+                statistics.oversize++;
+                return AllocateTemporary(size);
+            }
+
+            Fox::Vulkan::StagingAllocation allocation;
+            if (AllocateFromBlocks(size, alignment, allocation)) {
+                return allocation;
+            }
+
+            // give regions whose copies have completed back before growing
+            CollectLocked();
+            if (AllocateFromBlocks(size, alignment, allocation)) {
+                return allocation;
+            }
+
+            if (blocks.size() < maxBlocks) {
+                std::unique_ptr<Block> block = std::make_unique<Block>();
+                block->buffer = std::make_unique<Fox::Vulkan::Buffer<unsigned char>>();
+                block->buffer->Create(blockSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                block->mappedMemory = static_cast<uint8_t*>(block->buffer->GetMappedMemory());
+                block->allocator.Initialize(blockSize);
+                blocks.push_back(std::move(block));
+
+                if (AllocateFromBlocks(size, alignment, allocation)) {
+                    return allocation;
+                }
+            }
+
+            statistics.exhausted++;
+            if (!exhaustedReported) {
+                std::cout << "Warning: staging pool of " << blocks.size() << " x " << blockSize << " bytes is full, using temporary buffers." << std::endl;
+                exhaustedReported = true;
+            }
+            return AllocateTemporary(size);
+        }
+
+        bool StagingPool::AllocateFromBlocks(VkDeviceSize size, VkDeviceSize alignment, Fox::Vulkan::StagingAllocation& allocation) {
+            for (uint32_t i = 0u; i < blocks.size(); i++) {
+                Block* block = blocks[i].get();
+                if (!block->allocator.Allocate(size, alignment, allocation.range)) {
+                    continue;
+                }
+
+                allocation.buffer = block->buffer->GetBuffer();
+                allocation.offset = allocation.range.offset;
+                allocation.size = size;
+                allocation.data = block->mappedMemory + allocation.offset;
+                allocation.block = i;
+
+                statistics.hits++;
+                statistics.usedBytes += allocation.range.size;
+                statistics.peakBytes = std::max(statistics.peakBytes, statistics.usedBytes);
+                return true;
+            }
+            return false;
+        }
+
+        Fox::Vulkan::StagingAllocation StagingPool::AllocateTemporary(VkDeviceSize size) {
+            Fox::Vulkan::StagingAllocation allocation;
+            allocation.temporary = std::make_shared<Fox::Vulkan::Buffer<unsigned char>>();
+            allocation.temporary->Create(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            allocation.buffer = allocation.temporary->GetBuffer();
+            allocation.size = size;
+            allocation.data = allocation.temporary->GetMappedMemory();
+            return allocation;
+        }
+
+        void StagingPool::Free(Fox::Vulkan::StagingAllocation& allocation) {
+            std::lock_guard<std::mutex> lock(mutex);
+            FreeLocked(allocation);
+        }
+
+        void StagingPool::FreeLocked(Fox::Vulkan::StagingAllocation& allocation) {
+            if (!allocation.IsValid()) {
+                return;
+            }
+
+            if (!allocation.IsTemporary()) {
+                statistics.usedBytes -= allocation.range.size;
+                blocks[allocation.block]->allocator.Free(allocation.range);
+                exhaustedReported = false;
+            }
+            allocation = Fox::Vulkan::StagingAllocation();
+        }
+
+        void StagingPool::Release(Fox::Vulkan::StagingAllocation& allocation, VkFence fence) {
+            if (!allocation.IsValid()) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingReleases.push_back({ fence, allocation });
+            allocation = Fox::Vulkan::StagingAllocation();
+        }
+
+        void StagingPool::Retire(VkFence fence) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            for (auto it = pendingReleases.begin(); it != pendingReleases.end();) {
+                if (it->fence != fence) {
+                    ++it;
+                    continue;
+                }
+
+                FreeLocked(it->allocation);
+                it = pendingReleases.erase(it);
+            }
+        }
+
+        void StagingPool::Collect() {
+            std::lock_guard<std::mutex> lock(mutex);
+            CollectLocked();
+        }
+
+        void StagingPool::CollectLocked() {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+
+            for (auto it = pendingReleases.begin(); it != pendingReleases.end();) {
+                if (vkGetFenceStatus(device, it->fence) != VK_SUCCESS) {
+                    ++it;
+                    continue;
+                }
+
+                FreeLocked(it->allocation);
+                it = pendingReleases.erase(it);
+            }
+        }
+
+        Fox::Vulkan::StagingPoolStatistics StagingPool::GetStatistics() {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            Fox::Vulkan::StagingPoolStatistics result = statistics;
+            result.blocks = static_cast<uint32_t>(blocks.size());
+            result.blockBytes = blockSize * blocks.size();
+            result.pendingReleases = static_cast<uint32_t>(pendingReleases.size());
+            return result;
+        }
+
+        void StagingPool::PrintStatistics() {
+            Fox::Vulkan::StagingPoolStatistics result = GetStatistics();
+            std::cout << "Staging pool: " << result.usedBytes << "/" << result.blockBytes << " in " << result.blocks << " blocks (peak " << result.peakBytes
+                << ", hit rate " << result.GetHitRate() * 100.0f << "% of " << result.requests << " uploads, " << result.oversize << " oversize, "
+                << result.exhausted << " while full, " << result.pendingReleases << " waiting for fences)" << std::endl;
+        }
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		// a region of a staging block, or a temporary buffer of its own for uploads that do not fit
+		struct StagingAllocation {
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceSize offset = 0u;
+			VkDeviceSize size = 0u;
+			void* data = nullptr;
+			uint32_t block = ~0u;		// ~0u for temporary buffers
+			Fox::Core::TlsfAllocator::Allocation range;
+			std::shared_ptr<Fox::Vulkan::Buffer<unsigned char>> temporary;
+
+			inline bool IsValid() const {
+				return data != nullptr;
+			}
+
+			inline bool IsTemporary() const {
+				return temporary != nullptr;
+			}
+		};
+
+		struct StagingPoolStatistics {
+			uint32_t blocks = 0u;
+			uint64_t blockBytes = 0u;
+			uint64_t usedBytes = 0u;
+			uint64_t peakBytes = 0u;
+			uint64_t requests = 0u;
+			uint64_t hits = 0u;				// served from a block
+			uint64_t oversize = 0u;			// larger than a block
+			uint64_t exhausted = 0u;		// every block was full
+			uint32_t pendingReleases = 0u;
+
+			float GetHitRate() const {
+				return requests > 0u ? static_cast<float>(hits) / static_cast<float>(requests) : 1.0f;
+			}
+		};
+
+		// A few large, persistently mapped transfer source buffers that uploads sub-allocate from instead of creating a
+		// buffer each. A region handed to Release stays reserved until the fence of the submission reading it has signalled,
+		// Collect polls those fences. Blocks are created on demand up to maxBlocks and kept for the lifetime of the pool.
+		// Uploads larger than a block, or arriving while every block is taken, fall back to a temporary buffer.
+		// Allocating and releasing are thread safe, streaming workers fill their regions off the main thread.
+		class StagingPool {
+		public:
+			StagingPool(VkDeviceSize blockSize, uint32_t maxBlocks);
+			~StagingPool();
+
+			// alignment 0 uses the device's optimal copy offset alignment, which is enough for any texel block
+			Fox::Vulkan::StagingAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 0u);
+
+			// the copy has already completed, e.g. after a single time command
+			void Free(Fox::Vulkan::StagingAllocation& allocation);
+			// the region is reused once the fence has signalled, the fence has to outlive that or be passed to Retire first
+			void Release(Fox::Vulkan::StagingAllocation& allocation, VkFence fence);
+			// the fence is known to have signalled and is about to be destroyed
+			void Retire(VkFence fence);
+			void Collect();
+
+			Fox::Vulkan::StagingPoolStatistics GetStatistics();
+			void PrintStatistics();
+
+		private:
+
+			struct Block {
+				std::unique_ptr<Fox::Vulkan::Buffer<unsigned char>> buffer;
+				uint8_t* mappedMemory = nullptr;
+				Fox::Core::TlsfAllocator allocator;
+			};
+
+			struct PendingRelease {
+				VkFence fence;
+				Fox::Vulkan::StagingAllocation allocation;
+			};
+
+			bool AllocateFromBlocks(VkDeviceSize size, VkDeviceSize alignment, Fox::Vulkan::StagingAllocation& allocation);
+			Fox::Vulkan::StagingAllocation AllocateTemporary(VkDeviceSize size);
+			void FreeLocked(Fox::Vulkan::StagingAllocation& allocation);
+			void CollectLocked();
+
+			VkDeviceSize blockSize;
+			uint32_t maxBlocks;
+			VkDeviceSize copyAlignment = 16u;
+
+			std::vector<std::unique_ptr<Block>> blocks;
+			std::vector<PendingRelease> pendingReleases;
+			Fox::Vulkan::StagingPoolStatistics statistics;
+			bool exhaustedReported = false;
+			std::mutex mutex;
+		};
+	}
+}
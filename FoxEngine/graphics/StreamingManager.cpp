@@ -0,0 +1,511 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		StreamingManager::StreamingManager() {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = renderer->GetTransferQueueFamily();
+
+            if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create streaming command pool!");
+            }
+		}
+
+		StreamingManager::~StreamingManager() {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            // let the workers finish before the staging buffers they fill go away
+            for (auto& request : loadingModels) {
+                request->loaded.wait();
+                renderer->GetStagingPool()->Free(request->vertexStaging);
+                renderer->GetStagingPool()->Free(request->indexStaging);
+            }
+            for (auto& request : loadingTextures) {
+                request->loaded.wait();
+                renderer->GetStagingPool()->Free(request->staging);
+            }
+
+            vkQueueWaitIdle(renderer->GetTransferQueue());
+            RetireSubmissions();
+
+            for (auto& request : acquireModels) {
+                renderer->GetGeometryPool()->Free(request->geometry);
+            }
+
+            loadingModels.clear();
+            loadingTextures.clear();
+            acquireModels.clear();
+            acquireTextures.clear();
+
+            vkDestroyCommandPool(device, commandPool, nullptr);
+		}
+
+        void StreamingManager::RequestModel(std::shared_ptr<Fox::Vulkan::Model> model, const std::string& path) {
+            std::shared_ptr<Fox::Vulkan::Mesh> mesh;
+            Fox::Vulkan::Bounds bounds;
+            if (Fox::Vulkan::Renderer::GetRenderer()->GetMeshCache()->Find(path, mesh, bounds)) {
+                model->SetMesh(mesh, bounds);
+                return;
+            }
+
+            std::shared_ptr<ModelRequest> request = std::make_shared<ModelRequest>();
+            request->model = model;
+            request->path = path;
+
+            Fox::Vulkan::StagingPool* stagingPool = Fox::Vulkan::Renderer::GetRenderer()->GetStagingPool();
+
+            request->loaded = Fox::Vulkan::Renderer::GetRenderer()->GetThreadPool()->Submit([request, stagingPool]() {
+                Fox::Vulkan::MeshData data = Fox::Vulkan::Model::Import(request->path);
+
+                if (data.vertices.empty() || data.indices.empty()) {
+                    throw std::runtime_error("Model has no geometry!");
+                }
+
+                request->vertexCount = static_cast<uint32_t>(data.vertices.size());
+                request->indexCount = static_cast<uint32_t>(data.indices.size());
+                request->bounds = data.bounds;
+
+                VkDeviceSize vertexBufferSize = sizeof(Fox::Vulkan::Vertex) * data.vertices.size();
+                request->vertexStaging = stagingPool->Allocate(vertexBufferSize);
+                memcpy(request->vertexStaging.data, data.vertices.data(), vertexBufferSize);
+
+                VkDeviceSize indexBufferSize = sizeof(uint32_t) * data.indices.size();
+                request->indexStaging = stagingPool->Allocate(indexBufferSize);
+                memcpy(request->indexStaging.data, data.indices.data(), indexBufferSize);
+            });
+
+            loadingModels.push_back(request);
+            statistics.pendingModels++;
+        }
+
+        void StreamingManager::RequestTexture(const std::string& path, std::function<void(std::shared_ptr<Fox::Vulkan::Texture>)> onResident) {
+            std::shared_ptr<TextureRequest> request = std::make_shared<TextureRequest>();
+            request->path = path;
+            request->onResident = onResident;
+
+            Fox::Core::ThreadPool* threadPool = Fox::Vulkan::Renderer::GetRenderer()->GetThreadPool();
+            Fox::Vulkan::StagingPool* stagingPool = Fox::Vulkan::Renderer::GetRenderer()->GetStagingPool();
+            VkFormat format = TEXTURE_FORMAT;
+
+            // cooking runs on the worker, several textures in flight cook in parallel
+            request->loaded = threadPool->Submit([request, threadPool, stagingPool, format]() {
+                Fox::Core::TextureContainer container = Fox::Vulkan::TextureManager::LoadContainer(request->path, format, threadPool);
+
+                request->format = static_cast<VkFormat>(container.format);
+                request->width = container.width;
+                request->height = container.height;
+                request->mipLevels = static_cast<uint32_t>(container.levels.size());
+                request->layerCount = container.layerCount;
+                request->imageSize = static_cast<VkDeviceSize>(container.GetDataSize());
+                request->levels = container.levels;
+
+                request->staging = stagingPool->Allocate(request->imageSize);
+                memcpy(request->staging.data, container.GetData(), request->imageSize);
+            });
+
+            loadingTextures.push_back(request);
+            statistics.pendingTextures++;
+        }
+
+        void StreamingManager::RequestResize(const std::string& path, const Fox::Core::TextureContainer& container, uint32_t firstLevel,
+            std::function<void(std::shared_ptr<Fox::Vulkan::Texture>)> onResident) {
+            std::shared_ptr<TextureRequest> request = std::make_shared<TextureRequest>();
+            request->path = path;
+            request->onResident = onResident;
+            request->replacement = true;
+
+            Fox::Vulkan::StagingPool* stagingPool = Fox::Vulkan::Renderer::GetRenderer()->GetStagingPool();
+
+            // a mapped container is shared with the copy, the worker reads the file pages instead of the main thread
+            request->loaded = Fox::Vulkan::Renderer::GetRenderer()->GetThreadPool()->Submit([request, stagingPool, container, firstLevel]() {
+                const Fox::Core::TextureLevel& top = container.levels[firstLevel];
+
+                request->format = static_cast<VkFormat>(container.format);
+                request->width = top.width;
+                request->height = top.height;
+                request->mipLevels = static_cast<uint32_t>(container.levels.size()) - firstLevel;
+                request->layerCount = container.layerCount;
+                request->imageSize = static_cast<VkDeviceSize>(container.GetDataSize() - top.offset);
+
+                // levels are stored finest first, the ones from firstLevel on are one contiguous range
+                request->levels.assign(container.levels.begin() + firstLevel, container.levels.end());
+                for (Fox::Core::TextureLevel& level : request->levels) {
+                    level.offset -= top.offset;
+                }
+
+                request->staging = stagingPool->Allocate(request->imageSize);
+                memcpy(request->staging.data, container.GetData() + top.offset, request->imageSize);
+            });
+
+            loadingTextures.push_back(request);
+            statistics.pendingTextures++;
+        }
+
+        void StreamingManager::Update() {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            RetireSubmissions();
+
+            std::vector<std::shared_ptr<ModelRequest>> readyModels;
+            for (auto it = loadingModels.begin(); it != loadingModels.end();) {
+                std::shared_ptr<ModelRequest> request = *it;
+
+                if (request->loaded.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    ++it;
+                    continue;
+                }
+
+                it = loadingModels.erase(it);
+
+                try {
+                    request->loaded.get();
+                } catch (const std::exception& e) {
+                    std::cout << "Warning: failed to stream model " << request->path << ": " << e.what() << std::endl;
+                    renderer->GetStagingPool()->Free(request->vertexStaging);
+                    renderer->GetStagingPool()->Free(request->indexStaging);
+                    statistics.pendingModels--;
+                    continue;
+                }
+
+                if (!renderer->GetGeometryPool()->Allocate(request->vertexCount, request->indexCount, request->geometry)) {
+                    std::cout << "Warning: geometry pool is out of space for streamed model " << request->path << "." << std::endl;
+                    renderer->GetStagingPool()->Free(request->vertexStaging);
+                    renderer->GetStagingPool()->Free(request->indexStaging);
+                    statistics.pendingModels--;
+                    continue;
+                }
+
+                readyModels.push_back(request);
+            }
+
+            std::vector<std::shared_ptr<TextureRequest>> readyTextures;
+            for (auto it = loadingTextures.begin(); it != loadingTextures.end();) {
+                std::shared_ptr<TextureRequest> request = *it;
+
+                if (request->loaded.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    ++it;
+                    continue;
+                }
+
+                it = loadingTextures.erase(it);
+
+                try {
+                    request->loaded.get();
+                } catch (const std::exception& e) {
+                    std::cout << "Warning: failed to stream texture " << request->path << ": " << e.what() << std::endl;
+                    renderer->GetStagingPool()->Free(request->staging);
+                    statistics.pendingTextures--;
+                    // the texture being resized keeps its current image
+                    if (request->replacement && request->onResident) {
+                        request->onResident(nullptr);
+                    }
+                    continue;
+                }
+
+                // transfer source as well, a resize hands the image to the texture cache whose defragmentation copies it
+                request->texture = std::make_shared<Fox::Vulkan::Texture>(request->width, request->height, request->mipLevels, VK_SAMPLE_COUNT_1_BIT, request->format,
+                    VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_COLOR_BIT, request->layerCount);
+
+                readyTextures.push_back(request);
+            }
+
+            if (!readyModels.empty() || !readyTextures.empty()) {
+                SubmitUploads(readyModels, readyTextures);
+            }
+        }
+
+        void StreamingManager::SubmitUploads(std::vector<std::shared_ptr<ModelRequest>>& models, std::vector<std::shared_ptr<TextureRequest>>& textures) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            Fox::Vulkan::GeometryPool<Fox::Vulkan::Vertex, uint32_t>* geometryPool = renderer->GetGeometryPool();
+
+            bool dedicated = renderer->HasDedicatedTransferQueue();
+            uint32_t srcQueueFamily = dedicated ? renderer->GetTransferQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
+            uint32_t dstQueueFamily = dedicated ? renderer->GetGraphicsQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
+
+            Submission submission{};
+            submission.models = models;
+            submission.textures = textures;
+
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = commandPool;
+            allocInfo.commandBufferCount = 1;
+
+            if (vkAllocateCommandBuffers(device, &allocInfo, &submission.commandBuffer) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to allocate streaming command buffer!");
+            }
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(submission.commandBuffer, &beginInfo);
+
+            std::vector<VkBufferMemoryBarrier> bufferBarriers;
+
+            for (auto& request : models) {
+                VkBufferCopy vertexRegion{};
+                vertexRegion.dstOffset = sizeof(Fox::Vulkan::Vertex) * static_cast<VkDeviceSize>(request->geometry.vertexOffset);
+                vertexRegion.size = sizeof(Fox::Vulkan::Vertex) * static_cast<VkDeviceSize>(request->vertexCount);
+                vertexRegion.srcOffset = request->vertexStaging.offset;
+                vkCmdCopyBuffer(submission.commandBuffer, request->vertexStaging.buffer, geometryPool->GetVertexBuffer(), 1, &vertexRegion);
+
+                VkBufferCopy indexRegion{};
+                indexRegion.dstOffset = sizeof(uint32_t) * static_cast<VkDeviceSize>(request->geometry.firstIndex);
+                indexRegion.size = sizeof(uint32_t) * static_cast<VkDeviceSize>(request->indexCount);
+                indexRegion.srcOffset = request->indexStaging.offset;
+                vkCmdCopyBuffer(submission.commandBuffer, request->indexStaging.buffer, geometryPool->GetIndexBuffer(), 1, &indexRegion);
+
+                statistics.uploadedBytes += vertexRegion.size + indexRegion.size;
+
+                if (dedicated) {
+                    VkBufferMemoryBarrier barrier{};
+                    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    barrier.dstAccessMask = 0;
+                    barrier.srcQueueFamilyIndex = srcQueueFamily;
+                    barrier.dstQueueFamilyIndex = dstQueueFamily;
+
+                    barrier.buffer = geometryPool->GetVertexBuffer();
+                    barrier.offset = vertexRegion.dstOffset;
+                    barrier.size = vertexRegion.size;
+                    bufferBarriers.push_back(barrier);
+
+                    barrier.buffer = geometryPool->GetIndexBuffer();
+                    barrier.offset = indexRegion.dstOffset;
+                    barrier.size = indexRegion.size;
+                    bufferBarriers.push_back(barrier);
+                }
+            }
+
+            std::vector<VkImageMemoryBarrier> imageBarriers;
+
+            for (auto& request : textures) {
+                VkImageMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image = request->texture->GetImage();
+                barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                barrier.subresourceRange.baseMipLevel = 0;
+                barrier.subresourceRange.levelCount = request->mipLevels;
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount = request->layerCount;
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+                vkCmdPipelineBarrier(submission.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                    0, nullptr, 0, nullptr, 1, &barrier);
+
+                // the cooked container already holds every level, one region each
+                std::vector<VkBufferImageCopy> regions(request->levels.size());
+                for (size_t i = 0; i < regions.size(); i++) {
+                    VkBufferImageCopy& region = regions[i];
+                    region.bufferOffset = request->staging.offset + request->levels[i].offset;
+                    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                    region.imageSubresource.mipLevel = static_cast<uint32_t>(i);
+                    region.imageSubresource.baseArrayLayer = 0;
+                    region.imageSubresource.layerCount = request->layerCount;
+                    region.imageExtent = { request->levels[i].width, request->levels[i].height, 1 };
+                }
+
+                vkCmdCopyBufferToImage(submission.commandBuffer, request->staging.buffer, request->texture->GetImage(),
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+
+                statistics.uploadedBytes += request->imageSize;
+
+                // the final layout transition doubles as the release half when the queues differ
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = dedicated ? 0 : VK_ACCESS_SHADER_READ_BIT;
+                barrier.srcQueueFamilyIndex = srcQueueFamily;
+                barrier.dstQueueFamilyIndex = dstQueueFamily;
+                imageBarriers.push_back(barrier);
+            }
+
+            if (!bufferBarriers.empty()) {
+                vkCmdPipelineBarrier(submission.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                    0, nullptr,
+                    static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+                    0, nullptr);
+            }
+
+            if (!imageBarriers.empty()) {
+                vkCmdPipelineBarrier(submission.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    dedicated ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                    0, nullptr,
+                    0, nullptr,
+                    static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+            }
+
+            vkEndCommandBuffer(submission.commandBuffer);
+
+            VkFenceCreateInfo fenceInfo{};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+            if (vkCreateFence(device, &fenceInfo, nullptr, &submission.fence) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create streaming fence!");
+            }
+
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &submission.commandBuffer;
+
+            if (vkQueueSubmit(renderer->GetTransferQueue(), 1, &submitInfo, submission.fence) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to submit streaming uploads!");
+            }
+
+            // the regions go back to the staging pool when RetireSubmissions sees the fence
+            for (auto& request : models) {
+                renderer->GetStagingPool()->Release(request->vertexStaging, submission.fence);
+                renderer->GetStagingPool()->Release(request->indexStaging, submission.fence);
+            }
+            for (auto& request : textures) {
+                renderer->GetStagingPool()->Release(request->staging, submission.fence);
+            }
+
+            submissions.push_back(submission);
+        }
+
+        void StreamingManager::RetireSubmissions() {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+
+            for (auto it = submissions.begin(); it != submissions.end();) {
+                if (vkGetFenceStatus(device, it->fence) != VK_SUCCESS) {
+                    ++it;
+                    continue;
+                }
+
+                Fox::Vulkan::Renderer::GetRenderer()->GetStagingPool()->Retire(it->fence);
+                vkDestroyFence(device, it->fence, nullptr);
+                vkFreeCommandBuffers(device, commandPool, 1, &it->commandBuffer);
+
+                for (auto& request : it->models) {
+                    acquireModels.push_back(request);
+                }
+
+                for (auto& request : it->textures) {
+                    acquireTextures.push_back(request);
+                }
+
+                it = submissions.erase(it);
+            }
+        }
+
+        void StreamingManager::RecordOwnershipTransfers(VkCommandBuffer commandBuffer) {
+            if (acquireModels.empty() && acquireTextures.empty()) {
+                return;
+            }
+
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            Fox::Vulkan::GeometryPool<Fox::Vulkan::Vertex, uint32_t>* geometryPool = renderer->GetGeometryPool();
+
+            // with a shared queue these are plain memory barriers, the submission order already covers execution
+            bool dedicated = renderer->HasDedicatedTransferQueue();
+            uint32_t srcQueueFamily = dedicated ? renderer->GetTransferQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
+            uint32_t dstQueueFamily = dedicated ? renderer->GetGraphicsQueueFamily() : VK_QUEUE_FAMILY_IGNORED;
+            VkAccessFlags srcAccessMask = dedicated ? 0 : VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            std::vector<VkBufferMemoryBarrier> bufferBarriers;
+            for (auto& request : acquireModels) {
+                VkBufferMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                barrier.srcAccessMask = srcAccessMask;
+                barrier.srcQueueFamilyIndex = srcQueueFamily;
+                barrier.dstQueueFamilyIndex = dstQueueFamily;
+
+                barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+                barrier.buffer = geometryPool->GetVertexBuffer();
+                barrier.offset = sizeof(Fox::Vulkan::Vertex) * static_cast<VkDeviceSize>(request->geometry.vertexOffset);
+                barrier.size = sizeof(Fox::Vulkan::Vertex) * static_cast<VkDeviceSize>(request->geometry.vertexCount);
+                bufferBarriers.push_back(barrier);
+
+                barrier.dstAccessMask = VK_ACCESS_INDEX_READ_BIT;
+                barrier.buffer = geometryPool->GetIndexBuffer();
+                barrier.offset = sizeof(uint32_t) * static_cast<VkDeviceSize>(request->geometry.firstIndex);
+                barrier.size = sizeof(uint32_t) * static_cast<VkDeviceSize>(request->geometry.indexCount);
+                bufferBarriers.push_back(barrier);
+            }
+
+            // images were already made visible to shaders on the shared queue, only a dedicated queue needs the acquire
+            std::vector<VkImageMemoryBarrier> imageBarriers;
+            for (auto& request : acquireTextures) {
+                if (!dedicated) {
+                    continue;
+                }
+
+                VkImageMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                barrier.srcQueueFamilyIndex = srcQueueFamily;
+                barrier.dstQueueFamilyIndex = dstQueueFamily;
+                barrier.image = request->texture->GetImage();
+                barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                barrier.subresourceRange.baseMipLevel = 0;
+                barrier.subresourceRange.levelCount = request->mipLevels;
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount = request->layerCount;
+                imageBarriers.push_back(barrier);
+            }
+
+            if (!bufferBarriers.empty() || !imageBarriers.empty()) {
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                    0, nullptr,
+                    static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+                    static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+            }
+
+            for (auto& request : acquireTextures) {
+                if (request->onResident) {
+                    request->onResident(request->texture);
+                }
+                statistics.pendingTextures--;
+                if (!request->replacement) {
+                    residentTextures.push_back(request->texture);
+                    statistics.residentTextures++;
+                }
+            }
+
+            // commands recorded after this point may draw the models, the next batch build picks them up
+            for (auto& request : acquireModels) {
+                std::shared_ptr<Fox::Vulkan::Mesh> mesh = std::make_shared<Fox::Vulkan::Mesh>(request->geometry);
+                request->model->SetMesh(mesh, request->bounds);
+                renderer->GetMeshCache()->Insert(request->path, mesh, request->bounds);
+                statistics.pendingModels--;
+                statistics.residentModels++;
+            }
+
+            acquireModels.clear();
+            acquireTextures.clear();
+        }
+
+        std::vector<std::shared_ptr<Fox::Vulkan::Texture>> StreamingManager::GetResidentTextures() {
+            residentTextures.erase(std::remove_if(residentTextures.begin(), residentTextures.end(), [](const std::weak_ptr<Fox::Vulkan::Texture>& texture) {
+                return texture.expired();
+            }), residentTextures.end());
+
+            std::vector<std::shared_ptr<Fox::Vulkan::Texture>> textures;
+            for (const std::weak_ptr<Fox::Vulkan::Texture>& texture : residentTextures) {
+                textures.push_back(texture.lock());
+            }
+            return textures;
+        }
+	}
+}
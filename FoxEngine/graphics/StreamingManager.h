@@ -0,0 +1,101 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		struct StreamingStatistics {
+			uint32_t pendingModels = 0u;
+			uint32_t pendingTextures = 0u;
+			uint32_t residentModels = 0u;
+			uint32_t residentTextures = 0u;
+			uint64_t uploadedBytes = 0u;
+		};
+
+		// Loads models and textures on worker threads and uploads them on the transfer queue. Ownership of the
+		// uploaded ranges is released to the graphics queue family and acquired again at the start of a frame,
+		// after which the model becomes resident. Without a dedicated transfer family everything runs on the graphics queue.
+		class StreamingManager {
+		public:
+			StreamingManager();
+			~StreamingManager();
+
+			void RequestModel(std::shared_ptr<Fox::Vulkan::Model> model, const std::string& path);
+			void RequestTexture(const std::string& path, std::function<void(std::shared_ptr<Fox::Vulkan::Texture>)> onResident);
+			// uploads the levels from firstLevel on of an already loaded container into a new image, onResident swaps it into the
+			// texture it replaces. onResident gets null when the upload failed.
+			void RequestResize(const std::string& path, const Fox::Core::TextureContainer& container, uint32_t firstLevel,
+				std::function<void(std::shared_ptr<Fox::Vulkan::Texture>)> onResident);
+
+			// main thread, once per frame before recording
+			void Update();
+			// records the acquire half of the ownership transfers, must be outside of a render pass
+			void RecordOwnershipTransfers(VkCommandBuffer commandBuffer);
+
+			// textures handed out by RequestTexture that are still alive
+			std::vector<std::shared_ptr<Fox::Vulkan::Texture>> GetResidentTextures();
+
+			inline const Fox::Vulkan::StreamingStatistics& GetStatistics() const {
+				return statistics;
+			}
+
+		private:
+
+			struct ModelRequest {
+				std::shared_ptr<Fox::Vulkan::Model> model;
+				std::string path;
+				std::future<void> loaded;
+
+				uint32_t vertexCount = 0u;
+				uint32_t indexCount = 0u;
+				Fox::Vulkan::Bounds bounds;
+				Fox::Vulkan::StagingAllocation vertexStaging;
+				Fox::Vulkan::StagingAllocation indexStaging;
+
+				Fox::Vulkan::GeometryAllocation geometry;
+			};
+
+			struct TextureRequest {
+				std::string path;
+				std::function<void(std::shared_ptr<Fox::Vulkan::Texture>)> onResident;
+				std::future<void> loaded;
+
+				VkFormat format = VK_FORMAT_UNDEFINED;
+				uint32_t width = 0u;
+				uint32_t height = 0u;
+				uint32_t mipLevels = 1u;
+				uint32_t layerCount = 1u;
+				VkDeviceSize imageSize = 0u;
+				std::vector<Fox::Core::TextureLevel> levels;
+				Fox::Vulkan::StagingAllocation staging;
+
+				std::shared_ptr<Fox::Vulkan::Texture> texture;
+				bool replacement = false;	// a new image for an existing texture rather than a texture of its own
+			};
+
+			struct Submission {
+				VkCommandBuffer commandBuffer;
+				VkFence fence;
+				std::vector<std::shared_ptr<ModelRequest>> models;
+				std::vector<std::shared_ptr<TextureRequest>> textures;
+			};
+
+			void RetireSubmissions();
+			void SubmitUploads(std::vector<std::shared_ptr<ModelRequest>>& models, std::vector<std::shared_ptr<TextureRequest>>& textures);
+
+			const VkFormat TEXTURE_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+
+			VkCommandPool commandPool;
+
+			std::vector<std::shared_ptr<ModelRequest>> loadingModels;
+			std::vector<std::shared_ptr<TextureRequest>> loadingTextures;
+			std::vector<Submission> submissions;
+			std::vector<std::shared_ptr<ModelRequest>> acquireModels;
+			std::vector<std::shared_ptr<TextureRequest>> acquireTextures;
+			// the defragmentation moves these like cached textures, their owners keep their pointers
+			std::vector<std::weak_ptr<Fox::Vulkan::Texture>> residentTextures;
+
+			Fox::Vulkan::StreamingStatistics statistics;
+		};
+	}
+}
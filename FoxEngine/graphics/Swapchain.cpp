@@ -62,8 +62,7 @@ namespace Fox {
         Cleanup();
 
         Create();
-        CreateColorResources();
-        CreateDepthResources();
+        CreateAttachments();
         CreateFrameBuffers(renderPass);
     }
 
@@ -97,14 +96,6 @@ namespace Fox {
         return VK_PRESENT_MODE_FIFO_KHR;
     }
 
-    void Swapchain::CreateColorResources() {
-        Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
-        VkFormat colorFormat = imageFormat;
-
-        renderTexture = std::make_shared<Fox::Vulkan::RenderTexture>(extent.width, extent.height, 1, renderer->GetConfig().msaaSamples, colorFormat, VK_IMAGE_TILING_OPTIMAL,
-            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_COLOR_BIT);
-    }
-
     void Swapchain::Create() {
         VkDevice device = Fox::Vulkan::Renderer::GetDevice();
         Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
@@ -169,13 +160,38 @@ namespace Fox {
         this->extent = extent;
     }
 
-    void Swapchain::CreateDepthResources() {
+    // Multisampled colour and depth are only touched inside the render pass, the colour is resolved into the swapchain image
+    // and both are stored with DONT_CARE, so they are transient and can live in lazily allocated memory on tiled GPUs.
+    void Swapchain::CreateAttachments() {
         Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+        Fox::Vulkan::MemoryAllocator* memoryAllocator = renderer->GetMemoryAllocator();
+        VkSampleCountFlagBits samples = renderer->GetConfig().msaaSamples;
         VkFormat depthFormat = renderer->FindDepthFormat();
-        depthTexture = std::make_shared<Fox::Vulkan::DepthTexture>(extent.width, extent.height, 1,
-            renderer->GetConfig().msaaSamples, depthFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_DEPTH_BIT);
+        VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+        renderTexture = std::make_shared<Fox::Vulkan::RenderTexture>(extent.width, extent.height, 1, samples, imageFormat, VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, properties, VK_IMAGE_ASPECT_COLOR_BIT);
+
+        depthTexture = std::make_shared<Fox::Vulkan::DepthTexture>(extent.width, extent.height, 1, samples, depthFormat, VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, properties, VK_IMAGE_ASPECT_DEPTH_BIT);
         renderer->TransitionImageLayout(depthTexture->GetImage(), depthFormat, VK_IMAGE_LAYOUT_UNDEFINED,
             VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, 1);
+
+        VkDeviceSize totalBytes = 0u;
+        VkDeviceSize lazyBytes = 0u;
+        VkDeviceSize committedBytes = 0u;
+        std::array<const Fox::Vulkan::Texture*, 2> targets = { renderTexture.get(), depthTexture.get() };
+        for (const Fox::Vulkan::Texture* texture : targets) {
+            const Fox::Vulkan::MemoryAllocation& allocation = texture->GetAllocation();
+            totalBytes += allocation.size;
+            if (memoryAllocator->IsLazilyAllocated(allocation)) {
+                lazyBytes += allocation.size;
+                committedBytes += memoryAllocator->GetCommittedBytes(allocation);
+            }
+        }
+
+        std::cout << "Render targets at " << extent.width << "x" << extent.height << ": " << totalBytes << " bytes, " << lazyBytes
+            << " lazily allocated (" << committedBytes << " committed)" << std::endl;
     }
 
     void Swapchain::CreateFrameBuffers(VkRenderPass renderPass) {
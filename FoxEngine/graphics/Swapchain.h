@@ -22,8 +22,7 @@ namespace Fox {
 			void Cleanup();
 			void Recreate(VkRenderPass renderPass);
 			void Create();
-			void CreateColorResources();
-			void CreateDepthResources();
+			void CreateAttachments();
 			void CreateFrameBuffers(VkRenderPass renderPass);
 
 
@@ -5,9 +5,13 @@ namespace Fox {
 	namespace Vulkan {
 
 		Texture::Texture(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, 
-            VkFormat imageFormat, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImageAspectFlags aspectFlags) {
-            Create(width, height, mipLevels, numSamples, imageFormat, tiling, usage, properties, image, imageMemory);
-			imageView = CreateImageView(image, imageFormat, aspectFlags, mipLevels);
+            VkFormat imageFormat, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImageAspectFlags aspectFlags,
+            uint32_t arrayLayers) : width(width), height(height), format(imageFormat), mipLevels(mipLevels), arrayLayers(arrayLayers) {
+            Create(width, height, mipLevels, numSamples, imageFormat, tiling, usage, properties, image, allocation, arrayLayers);
+
+            // sampled textures are all bound as 2D arrays so plain textures, atlas pages and arrays share one shader
+            bool sampledOnly = (usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) == 0;
+			imageView = CreateImageView(image, imageFormat, aspectFlags, mipLevels, arrayLayers, sampledOnly);
             type = Fox::Vulkan::TextureType::NORMAL;
 		}
 
@@ -19,11 +23,15 @@ namespace Fox {
             }
             vkDestroyImageView(device, imageView, nullptr);
             vkDestroyImage(device, image, nullptr);
-            vkFreeMemory(device, imageMemory, nullptr);
+
+            Fox::Vulkan::MemoryAllocator* memoryAllocator = Fox::Vulkan::Renderer::GetRenderer()->GetMemoryAllocator();
+            if (memoryAllocator) {
+                memoryAllocator->Free(allocation);
+            }
         }
 	
         void Texture::Create(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
-            VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory) {
+            VkMemoryPropertyFlags properties, VkImage& image, Fox::Vulkan::MemoryAllocation& allocation, uint32_t arrayLayers) {
 
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
 
@@ -34,7 +42,7 @@ namespace Fox {
             imageInfo.extent.height = height;
             imageInfo.extent.depth = 1;
             imageInfo.mipLevels = mipLevels;
-            imageInfo.arrayLayers = 1;
+            imageInfo.arrayLayers = arrayLayers;
             imageInfo.format = format;
             imageInfo.tiling = tiling;
             imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -46,34 +54,40 @@ namespace Fox {
                 throw std::runtime_error("failed to create image!");
             }
 
-            VkMemoryRequirements memRequirements;
-            vkGetImageMemoryRequirements(device, image, &memRequirements);
-
-            VkMemoryAllocateInfo allocInfo{};
-            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocInfo.allocationSize = memRequirements.size;
-            allocInfo.memoryTypeIndex = Fox::Vulkan::Renderer::GetRenderer()->findMemoryType(memRequirements.memoryTypeBits, properties);
-
-            if (vkAllocateMemory(device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-                throw std::runtime_error("failed to allocate image memory!");
-            }
+            // render targets are large and recreated with the swapchain, they get memory of their own
+            bool renderTarget = (usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) != 0;
+            allocation = Fox::Vulkan::Renderer::GetRenderer()->GetMemoryAllocator()->AllocateForImage(image, properties, tiling == VK_IMAGE_TILING_LINEAR, renderTarget,
+                renderTarget ? Fox::Vulkan::MemoryCategory::RenderTarget : Fox::Vulkan::MemoryCategory::Texture);
+            memorySize = allocation.size;
+        }
 
-            vkBindImageMemory(device, image, imageMemory, 0);
+        void Texture::Swap(Fox::Vulkan::Texture& other) {
+            std::swap(image, other.image);
+            std::swap(allocation, other.allocation);
+            std::swap(imageView, other.imageView);
+            std::swap(width, other.width);
+            std::swap(height, other.height);
+            std::swap(format, other.format);
+            std::swap(mipLevels, other.mipLevels);
+            std::swap(arrayLayers, other.arrayLayers);
+            std::swap(memorySize, other.memorySize);
+            version++;
+            other.version++;
         }
 
-        VkImageView Texture::CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels) {
+        VkImageView Texture::CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels, uint32_t arrayLayers, bool arrayView) {
             VkDevice device = Fox::Vulkan::Renderer::GetDevice();
 
             VkImageViewCreateInfo viewInfo{};
             viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
             viewInfo.image = image;
-            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.viewType = arrayLayers > 1u || arrayView ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
             viewInfo.format = format;
             viewInfo.subresourceRange.aspectMask = aspectFlags;
             viewInfo.subresourceRange.baseMipLevel = 0;
             viewInfo.subresourceRange.levelCount = mipLevels;
             viewInfo.subresourceRange.baseArrayLayer = 0;
-            viewInfo.subresourceRange.layerCount = 1;
+            viewInfo.subresourceRange.layerCount = arrayLayers;
 
             VkImageView imageView;
             if (vkCreateImageView(device, &viewInfo, nullptr, &imageView) != VK_SUCCESS) {
@@ -15,12 +15,15 @@ namespace Fox {
 		public: 
 			Texture() = default;
 			Texture(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples,
-				VkFormat imageFormat, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImageAspectFlags aspectFlags);
+				VkFormat imageFormat, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImageAspectFlags aspectFlags,
+				uint32_t arrayLayers = 1u);
 			virtual ~Texture();
 
 			void Create(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
-				VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory);
-			VkImageView CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels);
+				VkMemoryPropertyFlags properties, VkImage& image, Fox::Vulkan::MemoryAllocation& allocation, uint32_t arrayLayers = 1u);
+			// more than one layer always creates a 2D array view, a single layer only when asked to
+			VkImageView CreateImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels, uint32_t arrayLayers = 1u,
+				bool arrayView = false);
 
 			inline VkImage GetImage() {
 				return image;
@@ -30,12 +33,55 @@ namespace Fox {
 				return imageView;
 			}
 
+			inline uint32_t GetWidth() const {
+				return width;
+			}
+
+			inline uint32_t GetHeight() const {
+				return height;
+			}
+
+			inline VkFormat GetFormat() const {
+				return format;
+			}
+
+			inline const Fox::Vulkan::MemoryAllocation& GetAllocation() const {
+				return allocation;
+			}
+
+			inline uint32_t GetMipLevels() const {
+				return mipLevels;
+			}
+
+			inline uint32_t GetArrayLayers() const {
+				return arrayLayers;
+			}
+
+			inline VkDeviceSize GetMemorySize() const {
+				return memorySize;
+			}
+
+			// bumped whenever the image behind this texture changes, descriptors written for an older version are stale
+			inline uint64_t GetVersion() const {
+				return version;
+			}
+
+			// exchanges the GPU resources of both textures, used to resize a texture in place while others hold a pointer to it
+			void Swap(Fox::Vulkan::Texture& other);
+
 		protected:
 
 			VkImage image;
-			VkDeviceMemory imageMemory;
+			Fox::Vulkan::MemoryAllocation allocation;
 			VkImageView imageView;
 			TextureType type;
+			uint32_t width = 0u;
+			uint32_t height = 0u;
+			VkFormat format = VK_FORMAT_UNDEFINED;
+			uint32_t mipLevels = 1u;
+			uint32_t arrayLayers = 1u;
+			VkDeviceSize memorySize = 0u;
+			uint64_t version = 0u;
 		};
 
 		class DepthTexture : public Fox::Vulkan::Texture {
@@ -0,0 +1,214 @@
+#include "pch.h"
+
+#include <STB_Image/stb_image.h>
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		TextureAtlas::~TextureAtlas() {
+            Fox::Vulkan::TextureManager* textureManager = Fox::Vulkan::Renderer::GetRenderer()->GetTextureManager();
+            if (textureManager) {
+                textureManager->DestroyTexture(texture);
+            }
+		}
+
+        void TextureAtlas::Build(const std::vector<std::string>& paths, VkFormat format) {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            Fox::Vulkan::TextureManager* textureManager = renderer->GetTextureManager();
+            Fox::Core::ThreadPool* threadPool = renderer->GetThreadPool();
+
+            textureManager->DestroyTexture(texture);
+            regions.clear();
+            statistics = Fox::Vulkan::TextureAtlasStatistics();
+
+            if (paths.empty()) {
+                return;
+            }
+
+            format = textureManager->ResolveFormat("atlas", format);
+
+            std::vector<Source> sources(paths.size());
+            threadPool->ParallelFor(static_cast<uint32_t>(paths.size()), [&paths, &sources](uint32_t i) {
+                Source& source = sources[i];
+                source.path = paths[i];
+
+                int texWidth, texHeight, texChannels;
+                stbi_uc* pixels = stbi_load(source.path.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+                if (!pixels) {
+                    return;
+                }
+
+                source.image.width = static_cast<uint32_t>(texWidth);
+                source.image.height = static_cast<uint32_t>(texHeight);
+                source.image.pixels.assign(pixels, pixels + static_cast<size_t>(texWidth) * texHeight * 4u);
+                stbi_image_free(pixels);
+            });
+
+            for (auto it = sources.begin(); it != sources.end();) {
+                if (it->image.width == 0u) {
+                    std::cout << "Warning: could not load atlas texture " << it->path << "." << std::endl;
+                    statistics.rejected++;
+                    it = sources.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            if (sources.empty()) {
+                return;
+            }
+
+            bool uniform = std::all_of(sources.begin(), sources.end(), [&sources](const Source& source) {
+                return source.image.width == sources[0].image.width && source.image.height == sources[0].image.height;
+            });
+
+            Fox::Core::BlockFormat blockFormat;
+            uint32_t blockAlignment = Fox::Vulkan::TextureManager::GetBlockFormat(format, blockFormat) ? 4u : 1u;
+            bool srgb = Fox::Vulkan::TextureManager::IsSrgbFormat(format);
+
+            std::vector<std::vector<Fox::Core::MipImage>> layers = uniform ? BuildLayers(sources, srgb) : BuildPages(sources, srgb, blockAlignment);
+            if (layers.empty()) {
+                return;
+            }
+
+            Fox::Core::TextureContainer container = Fox::Vulkan::TextureManager::CookLayers(layers, format, threadPool);
+            texture = textureManager->CreateTexture(container);
+
+            statistics.layers = static_cast<uint32_t>(layers.size());
+            statistics.textures = static_cast<uint32_t>(regions.size());
+
+            std::cout << "Packed " << statistics.textures << " textures into " << statistics.layers << " layers of " << container.width << "x" << container.height
+                << " (" << statistics.occupancy * 100.0f << "% occupied, " << statistics.rejected << " rejected)" << std::endl;
+        }
+
+        std::vector<std::vector<Fox::Core::MipImage>> TextureAtlas::BuildLayers(std::vector<Source>& sources, bool srgb) {
+            Fox::Core::ThreadPool* threadPool = Fox::Vulkan::Renderer::GetRenderer()->GetThreadPool();
+
+            std::vector<std::vector<Fox::Core::MipImage>> layers;
+            for (Source& source : sources) {
+                source.layer = static_cast<uint32_t>(layers.size());
+                source.packed = true;
+
+                layers.push_back(Fox::Core::MipGenerator::Generate(source.image.pixels.data(), source.image.width, source.image.height,
+                    Fox::Core::MipFilter::Kaiser, srgb, threadPool));
+
+                Fox::Vulkan::TextureAtlasRegion region;
+                region.layer = source.layer;
+                regions[source.path] = region;
+            }
+
+            statistics.occupancy = 1.0f;
+            return layers;
+        }
+
+        std::vector<std::vector<Fox::Core::MipImage>> TextureAtlas::BuildPages(std::vector<Source>& sources, bool srgb, uint32_t alignment) {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            const Fox::Vulkan::RendererConfig& config = renderer->GetConfig();
+
+            uint32_t pageSize = config.atlasPageSize;
+
+            // box filtering halves the gutter each level, it has to keep at least one texel down the chain
+            uint32_t levelCount = std::min(static_cast<uint32_t>(std::log2(std::max(config.atlasPadding, 1u))) + 1u,
+                Fox::Core::MipGenerator::GetLevelCount(pageSize, pageSize));
+            uint32_t padding = 1u << (levelCount - 1u);
+            alignment = std::max(alignment, padding);
+
+            auto align = [alignment](uint32_t size) {
+                return (size + alignment - 1u) / alignment * alignment;
+            };
+
+            // tallest first gives the skyline the flattest top
+            std::vector<Source*> order;
+            for (Source& source : sources) {
+                order.push_back(&source);
+            }
+            std::sort(order.begin(), order.end(), [](const Source* a, const Source* b) {
+                return a->image.height != b->image.height ? a->image.height > b->image.height : a->image.width > b->image.width;
+            });
+
+            std::vector<Fox::Core::SkylinePacker> pages;
+            uint64_t packedArea = 0u;
+
+            for (Source* source : order) {
+                uint32_t cellWidth = align(source->image.width + 2u * padding);
+                uint32_t cellHeight = align(source->image.height + 2u * padding);
+
+                if (cellWidth > pageSize || cellHeight > pageSize) {
+                    std::cout << "Warning: texture " << source->path << " does not fit into an atlas page of " << pageSize << "." << std::endl;
+                    statistics.rejected++;
+                    continue;
+                }
+
+                for (uint32_t page = 0u; page < pages.size() && !source->packed; page++) {
+                    if (pages[page].Insert(cellWidth, cellHeight, source->x, source->y)) {
+                        source->layer = page;
+                        source->packed = true;
+                    }
+                }
+
+                if (!source->packed) {
+                    pages.emplace_back(pageSize, pageSize);
+                    pages.back().Insert(cellWidth, cellHeight, source->x, source->y);
+                    source->layer = static_cast<uint32_t>(pages.size()) - 1u;
+                    source->packed = true;
+                }
+
+                packedArea += static_cast<uint64_t>(source->image.width) * source->image.height;
+            }
+
+            std::vector<std::vector<uint8_t>> pixels(pages.size(), std::vector<uint8_t>(static_cast<size_t>(pageSize) * pageSize * 4u, 0u));
+
+            for (Source& source : sources) {
+                if (!source.packed) {
+                    continue;
+                }
+
+                // the whole cell is filled, texels outside the image repeat its nearest edge
+                uint32_t cellWidth = align(source.image.width + 2u * padding);
+                uint32_t cellHeight = align(source.image.height + 2u * padding);
+                uint8_t* page = pixels[source.layer].data();
+
+                for (uint32_t y = 0u; y < cellHeight; y++) {
+                    uint32_t sourceY = static_cast<uint32_t>(std::clamp(static_cast<int32_t>(y) - static_cast<int32_t>(padding), 0, static_cast<int32_t>(source.image.height) - 1));
+                    for (uint32_t x = 0u; x < cellWidth; x++) {
+                        uint32_t sourceX = static_cast<uint32_t>(std::clamp(static_cast<int32_t>(x) - static_cast<int32_t>(padding), 0, static_cast<int32_t>(source.image.width) - 1));
+                        memcpy(&page[(static_cast<size_t>(source.y + y) * pageSize + source.x + x) * 4u],
+                            &source.image.pixels[(static_cast<size_t>(sourceY) * source.image.width + sourceX) * 4u], 4u);
+                    }
+                }
+
+                float scale = 1.0f / static_cast<float>(pageSize);
+
+                Fox::Vulkan::TextureAtlasRegion region;
+                region.layer = source.layer;
+                region.texCoordTransform = glm::vec4(source.image.width * scale, source.image.height * scale,
+                    (source.x + padding) * scale, (source.y + padding) * scale);
+                regions[source.path] = region;
+            }
+
+            std::vector<std::vector<Fox::Core::MipImage>> layers;
+            for (std::vector<uint8_t>& page : pixels) {
+                std::vector<Fox::Core::MipImage> chain = Fox::Core::MipGenerator::Generate(page.data(), pageSize, pageSize, Fox::Core::MipFilter::Box,
+                    srgb, renderer->GetThreadPool());
+                chain.resize(levelCount);
+                layers.push_back(std::move(chain));
+            }
+
+            uint64_t pageArea = static_cast<uint64_t>(pageSize) * pageSize * pages.size();
+            statistics.occupancy = pageArea > 0u ? static_cast<float>(packedArea) / static_cast<float>(pageArea) : 0.0f;
+
+            return layers;
+        }
+
+        bool TextureAtlas::Find(const std::string& path, Fox::Vulkan::TextureAtlasRegion& region) const {
+            auto it = regions.find(path);
+            if (it == regions.end()) {
+                return false;
+            }
+
+            region = it->second;
+            return true;
+        }
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		// where a packed texture ended up, applied per draw as uv * scale + offset on the given layer
+		struct TextureAtlasRegion {
+			uint32_t layer = 0u;
+			glm::vec4 texCoordTransform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);	// scale in xy, offset in zw
+		};
+
+		struct TextureAtlasStatistics {
+			uint32_t textures = 0u;
+			uint32_t rejected = 0u;		// larger than a page, left out
+			uint32_t layers = 0u;
+			float occupancy = 0.0f;		// of all atlas pages together
+		};
+
+		// Packs many small textures into one 2D array texture so they can all be drawn with the same descriptor set.
+		// Textures of one common size become one layer each with their full mip chain. Mixed sizes are skyline packed into
+		// pages, one page per layer, each texture surrounded by a gutter of replicated edge texels and aligned so that the
+		// box filtered mips keep at least one gutter texel per level, which limits the chain to log2(padding) + 1 levels.
+		// Texture coordinates must stay within [0, 1] as repeating would sample the neighbours.
+		class TextureAtlas {
+		public:
+			TextureAtlas() = default;
+			~TextureAtlas();
+
+			void Build(const std::vector<std::string>& paths, VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+
+			bool Find(const std::string& path, Fox::Vulkan::TextureAtlasRegion& region) const;
+
+			inline Fox::Vulkan::Texture* GetTexture() {
+				return texture.get();
+			}
+
+			inline const Fox::Vulkan::TextureAtlasStatistics& GetStatistics() const {
+				return statistics;
+			}
+
+		private:
+
+			struct Source {
+				std::string path;
+				Fox::Core::MipImage image;
+				uint32_t layer = 0u;
+				uint32_t x = 0u;
+				uint32_t y = 0u;
+				bool packed = false;
+			};
+
+			std::vector<std::vector<Fox::Core::MipImage>> BuildLayers(std::vector<Source>& sources, bool srgb);
+			std::vector<std::vector<Fox::Core::MipImage>> BuildPages(std::vector<Source>& sources, bool srgb, uint32_t alignment);
+
+			std::shared_ptr<Fox::Vulkan::Texture> texture;
+			std::unordered_map<std::string, Fox::Vulkan::TextureAtlasRegion> regions;
+			Fox::Vulkan::TextureAtlasStatistics statistics;
+		};
+	}
+}
@@ -0,0 +1,331 @@
+#include "pch.h"
+
+#include <filesystem>
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		TextureImporter::TextureImporter(VkDeviceSize stagingSize) : stagingSize(stagingSize) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            // mapped once, the workers write into it for the whole import
+            stagingBuffer = std::make_unique<Fox::Vulkan::Buffer<unsigned char>>();
+            stagingBuffer->Create(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            stagingMemory = static_cast<uint8_t*>(stagingBuffer->GetMappedMemory());
+
+            // uploads go through the graphics queue so the textures end up sampleable without an ownership transfer
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = renderer->GetGraphicsQueueFamily();
+
+            if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create import command pool!");
+            }
+		}
+
+		TextureImporter::~TextureImporter() {
+            RetireSubmissions(true);
+            vkDestroyCommandPool(Fox::Vulkan::Renderer::GetDevice(), commandPool, nullptr);
+		}
+
+        std::vector<std::string> TextureImporter::FindImages(const std::string& directory) {
+            std::vector<std::string> paths;
+
+            std::error_code error;
+            for (const auto& file : std::filesystem::recursive_directory_iterator(directory, error)) {
+                if (!file.is_regular_file()) {
+                    continue;
+                }
+
+                std::string extension = file.path().extension().string();
+                std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+
+                if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == Fox::Core::TextureContainer::EXTENSION) {
+                    paths.push_back(file.path().generic_string());
+                }
+            }
+
+            if (error) {
+                std::cout << "Warning: could not list images in " << directory << ": " << error.message() << std::endl;
+            }
+
+            std::sort(paths.begin(), paths.end());
+            return paths;
+        }
+
+        void TextureImporter::Import(std::vector<Fox::Vulkan::TextureImport>& imports, std::function<uint32_t(const Fox::Core::TextureContainer&)> selectFirstLevel) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            Fox::Core::ThreadPool* threadPool = renderer->GetThreadPool();
+
+            statistics = Fox::Vulkan::TextureImportStatistics();
+            auto start = std::chrono::high_resolution_clock::now();
+
+            // one texture per task, each cooks single threaded so the pool is spread across textures instead of within one
+            std::vector<std::future<void>> loaded;
+            loaded.reserve(imports.size());
+
+            for (size_t i = 0; i < imports.size(); i++) {
+                loaded.push_back(threadPool->Submit([this, &imports, i, &selectFirstLevel]() {
+                    Fox::Vulkan::TextureImport& import = imports[i];
+                    ReadyImport item;
+                    item.index = i;
+
+                    try {
+                        import.container = Fox::Vulkan::TextureManager::LoadContainer(import.path, import.format, nullptr);
+
+                        uint32_t lastLevel = static_cast<uint32_t>(import.container.levels.size()) - 1u;
+                        import.firstLevel = selectFirstLevel ? std::min(selectFirstLevel(import.container), lastLevel) : 0u;
+
+                        const Fox::Core::TextureLevel& top = import.container.levels[import.firstLevel];
+                        VkDeviceSize size = static_cast<VkDeviceSize>(import.container.GetDataSize() - top.offset);
+                        const uint8_t* source = import.container.GetData() + top.offset;
+
+                        if (Reserve(size, item.offset)) {
+                            memcpy(stagingMemory + item.offset, source, static_cast<size_t>(size));
+                        } else {
+                            item.oversizeBuffer = std::make_shared<Fox::Vulkan::Buffer<unsigned char>>();
+                            item.oversizeBuffer->Create(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                            item.oversizeBuffer->CopyImage(size, const_cast<unsigned char*>(source));
+                        }
+                    } catch (const std::exception& e) {
+                        std::cout << "Warning: failed to import texture " << import.path << ": " << e.what() << std::endl;
+                        item.failed = true;
+                    }
+
+                    std::lock_guard<std::mutex> lock(readyMutex);
+                    ready.push_back(std::move(item));
+                    readyAvailable.notify_one();
+                }));
+            }
+
+            // records whatever finished since the last batch while the workers keep decoding the rest
+            size_t completed = 0u;
+            while (completed < imports.size()) {
+                std::vector<ReadyImport> batch;
+                {
+                    std::unique_lock<std::mutex> lock(readyMutex);
+                    readyAvailable.wait_for(lock, std::chrono::milliseconds(1), [this]() { return !ready.empty(); });
+                    batch.swap(ready);
+                }
+
+                // workers waiting for ring space depend on this, so it runs even when nothing new arrived
+                RetireSubmissions(false);
+
+                if (batch.empty()) {
+                    continue;
+                }
+                completed += batch.size();
+
+                Submission submission{};
+
+                for (ReadyImport& item : batch) {
+                    if (item.failed) {
+                        statistics.failed++;
+                        continue;
+                    }
+
+                    if (submission.commandBuffer == VK_NULL_HANDLE) {
+                        VkCommandBufferAllocateInfo allocInfo{};
+                        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                        allocInfo.commandPool = commandPool;
+                        allocInfo.commandBufferCount = 1;
+
+                        if (vkAllocateCommandBuffers(device, &allocInfo, &submission.commandBuffer) != VK_SUCCESS) {
+                            throw std::runtime_error("Failed to allocate import command buffer!");
+                        }
+
+                        VkCommandBufferBeginInfo beginInfo{};
+                        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                        vkBeginCommandBuffer(submission.commandBuffer, &beginInfo);
+                    }
+
+                    Fox::Vulkan::TextureImport& import = imports[item.index];
+                    if (item.oversizeBuffer) {
+                        RecordUpload(submission.commandBuffer, import, item.oversizeBuffer->GetBuffer(), 0u);
+                        submission.oversizeBuffers.push_back(item.oversizeBuffer);
+                    } else {
+                        RecordUpload(submission.commandBuffer, import, stagingBuffer->GetBuffer(), item.offset);
+                        submission.reservations.push_back(item.offset);
+                    }
+                }
+
+                if (submission.commandBuffer == VK_NULL_HANDLE) {
+                    continue;
+                }
+
+                vkEndCommandBuffer(submission.commandBuffer);
+
+                VkFenceCreateInfo fenceInfo{};
+                fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+                if (vkCreateFence(device, &fenceInfo, nullptr, &submission.fence) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to create import fence!");
+                }
+
+                VkSubmitInfo submitInfo{};
+                submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers = &submission.commandBuffer;
+
+                if (vkQueueSubmit(renderer->GetGraphicsQueue(), 1, &submitInfo, submission.fence) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to submit texture imports!");
+                }
+
+                submissions.push_back(std::move(submission));
+            }
+
+            for (auto& task : loaded) {
+                task.get();
+            }
+
+            RetireSubmissions(true);
+
+            statistics.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        void TextureImporter::RecordUpload(VkCommandBuffer commandBuffer, Fox::Vulkan::TextureImport& import, VkBuffer buffer, VkDeviceSize offset) {
+            const Fox::Core::TextureContainer& container = import.container;
+            const Fox::Core::TextureLevel& top = container.levels[import.firstLevel];
+            uint32_t mipLevels = static_cast<uint32_t>(container.levels.size()) - import.firstLevel;
+
+            import.texture = std::make_shared<Fox::Vulkan::Texture>(top.width, top.height, mipLevels, VK_SAMPLE_COUNT_1_BIT, static_cast<VkFormat>(container.format),
+                VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_COLOR_BIT, container.layerCount);
+
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = import.texture->GetImage();
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.baseMipLevel = 0;
+            barrier.subresourceRange.levelCount = mipLevels;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount = container.layerCount;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                0, nullptr, 0, nullptr, 1, &barrier);
+
+            std::vector<VkBufferImageCopy> regions(mipLevels);
+            for (uint32_t i = 0; i < mipLevels; i++) {
+                const Fox::Core::TextureLevel& level = container.levels[import.firstLevel + i];
+
+                VkBufferImageCopy& region = regions[i];
+                region.bufferOffset = offset + level.offset - top.offset;
+                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.imageSubresource.mipLevel = i;
+                region.imageSubresource.baseArrayLayer = 0;
+                region.imageSubresource.layerCount = container.layerCount;
+                region.imageExtent = { level.width, level.height, 1 };
+            }
+
+            vkCmdCopyBufferToImage(commandBuffer, buffer, import.texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                static_cast<uint32_t>(regions.size()), regions.data());
+
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                0, nullptr, 0, nullptr, 1, &barrier);
+
+            statistics.textures++;
+            statistics.uploadedBytes += container.GetDataSize() - top.offset;
+        }
+
+        bool TextureImporter::Reserve(VkDeviceSize size, VkDeviceSize& offset) {
+            size = Fox::Core::TextureContainer::AlignLevelOffset(size);
+
+            // the ring never fills up completely, a head equal to the tail always means empty
+            if (size >= stagingSize) {
+                return false;
+            }
+
+            std::unique_lock<std::mutex> lock(ringMutex);
+
+            ringReleased.wait(lock, [this, size, &offset]() {
+                if (reservations.empty()) {
+                    ringHead = 0u;
+                    offset = 0u;
+                    return true;
+                }
+
+                VkDeviceSize tail = reservations.front().offset;
+                if (ringHead >= tail) {
+                    if (ringHead + size <= stagingSize) {
+                        offset = ringHead;
+                        return true;
+                    }
+                    if (size < tail) {
+                        offset = 0u;
+                        return true;
+                    }
+                    return false;
+                }
+
+                if (ringHead + size < tail) {
+                    offset = ringHead;
+                    return true;
+                }
+                return false;
+            });
+
+            reservations.push_back({ offset, size, false });
+            ringHead = offset + size;
+            return true;
+        }
+
+        void TextureImporter::Retire(VkDeviceSize offset) {
+            {
+                std::lock_guard<std::mutex> lock(ringMutex);
+
+                for (Reservation& reservation : reservations) {
+                    if (reservation.offset == offset && !reservation.retired) {
+                        reservation.retired = true;
+                        break;
+                    }
+                }
+
+                // space only comes back in ring order, a retired reservation behind a pending one waits for it
+                while (!reservations.empty() && reservations.front().retired) {
+                    reservations.pop_front();
+                }
+            }
+
+            ringReleased.notify_all();
+        }
+
+        void TextureImporter::RetireSubmissions(bool wait) {
+            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+
+            for (auto it = submissions.begin(); it != submissions.end();) {
+                if (wait) {
+                    vkWaitForFences(device, 1, &it->fence, VK_TRUE, UINT64_MAX);
+                } else if (vkGetFenceStatus(device, it->fence) != VK_SUCCESS) {
+                    ++it;
+                    continue;
+                }
+
+                vkDestroyFence(device, it->fence, nullptr);
+                vkFreeCommandBuffers(device, commandPool, 1, &it->commandBuffer);
+
+                for (VkDeviceSize offset : it->reservations) {
+                    Retire(offset);
+                }
+
+                it = submissions.erase(it);
+            }
+        }
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		struct TextureImportStatistics {
+			uint32_t textures = 0u;
+			uint32_t failed = 0u;
+			uint64_t uploadedBytes = 0u;
+			double seconds = 0.0;
+
+			double GetMegabytesPerSecond() const {
+				return seconds > 0.0 ? static_cast<double>(uploadedBytes) / (1024.0 * 1024.0) / seconds : 0.0;
+			}
+
+			double GetTexturesPerSecond() const {
+				return seconds > 0.0 ? static_cast<double>(textures) / seconds : 0.0;
+			}
+		};
+
+		struct TextureImport {
+			std::string path;
+			VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+
+			// filled in by the import, texture stays null when loading failed
+			Fox::Core::TextureContainer container;
+			uint32_t firstLevel = 0u;
+			std::shared_ptr<Fox::Vulkan::Texture> texture;
+		};
+
+		// Bulk texture loader. Workers load or cook the containers concurrently and copy the levels straight into a persistently
+		// mapped staging ring while the main thread records the copies of finished textures and submits them, so decoding the next
+		// textures overlaps with the GPU uploading the previous ones. Ring space is recycled as the submissions' fences signal.
+		class TextureImporter {
+		public:
+			TextureImporter(VkDeviceSize stagingSize);
+			~TextureImporter();
+
+			// selects the first level to upload for a loaded container, all levels when not set
+			void Import(std::vector<Fox::Vulkan::TextureImport>& imports, std::function<uint32_t(const Fox::Core::TextureContainer&)> selectFirstLevel = nullptr);
+
+			static std::vector<std::string> FindImages(const std::string& directory);
+
+			inline const Fox::Vulkan::TextureImportStatistics& GetStatistics() const {
+				return statistics;
+			}
+
+		private:
+
+			struct Reservation {
+				VkDeviceSize offset = 0u;
+				VkDeviceSize size = 0u;
+				bool retired = false;
+			};
+
+			struct ReadyImport {
+				size_t index = 0u;
+				bool failed = false;
+				VkDeviceSize offset = 0u;
+				// set when the texture did not fit into the ring
+				std::shared_ptr<Fox::Vulkan::Buffer<unsigned char>> oversizeBuffer;
+			};
+
+			struct Submission {
+				VkCommandBuffer commandBuffer;
+				VkFence fence;
+				std::vector<VkDeviceSize> reservations;
+				std::vector<std::shared_ptr<Fox::Vulkan::Buffer<unsigned char>>> oversizeBuffers;
+			};
+
+			// blocks the calling worker until the ring has room, returns false when the size can never fit
+			bool Reserve(VkDeviceSize size, VkDeviceSize& offset);
+			void Retire(VkDeviceSize offset);
+			void RecordUpload(VkCommandBuffer commandBuffer, Fox::Vulkan::TextureImport& import, VkBuffer buffer, VkDeviceSize offset);
+			void RetireSubmissions(bool wait);
+
+			VkDeviceSize stagingSize;
+			std::unique_ptr<Fox::Vulkan::Buffer<unsigned char>> stagingBuffer;
+			uint8_t* stagingMemory = nullptr;
+			VkCommandPool commandPool;
+
+			std::mutex ringMutex;
+			std::condition_variable ringReleased;
+			std::deque<Reservation> reservations;
+			VkDeviceSize ringHead = 0u;
+
+			std::mutex readyMutex;
+			std::condition_variable readyAvailable;
+			std::vector<ReadyImport> ready;
+
+			std::deque<Submission> submissions;
+
+			Fox::Vulkan::TextureImportStatistics statistics;
+		};
+	}
+}
@@ -7,129 +7,727 @@ namespace Fox {
 
 	namespace Vulkan {
 		
+        const std::string TextureManager::CACHE_DIRECTORY = "cache/";
+
+		TextureManager::TextureManager(uint32_t numFramesInFlight) : numFramesInFlight(numFramesInFlight) {
+		}
+
 		TextureManager::~TextureManager() {
-			texture = nullptr;
+            for (auto& entry : textures) {
+                if (entry.second.referenceCount > 0u) {
+                    std::cout << "Warning: texture " << entry.first << " destroyed with " << entry.second.referenceCount << " references." << std::endl;
+                }
+                DestroyTexture(entry.second.texture);
+            }
+            textures.clear();
+            textureKeys.clear();
+            pendingReleases.clear();
+            retiredTextures.clear();
+            pendingMoves.clear();
+
+            DestroyTexture(defaultTexture);
 		}
 
-        void TextureManager::CreateTextures(uint32_t mipLevels) {
+        void TextureManager::CreateTextures() {
+            Fox::Core::TextureContainer white;
+            white.format = static_cast<uint32_t>(VK_FORMAT_R8G8B8A8_SRGB);
+            white.width = 1u;
+            white.height = 1u;
+            white.data = { 255, 255, 255, 255 };
+            white.levels.push_back({ 1u, 1u, 0u, 4u });
+            defaultTexture = CreateTexture(white);
+        }
 
-            VkDevice device = Fox::Vulkan::Renderer::GetDevice();
+        std::string TextureManager::GetKey(const std::string& path, VkFormat format) {
+            return path + ":" + std::to_string(static_cast<int32_t>(format));
+        }
+
+        std::string TextureManager::GetCachePath(const std::string& path, VkFormat format, Fox::Core::MipFilter filter) {
+            std::string name = path;
+            std::replace_if(name.begin(), name.end(), [](char c) { return c == '/' || c == '\\' || c == ':'; }, '_');
+            return name + "." + std::to_string(static_cast<int32_t>(format)) + "." + std::to_string(static_cast<uint32_t>(filter)) + Fox::Core::TextureContainer::EXTENSION;
+        }
+
+        bool TextureManager::GetBlockFormat(VkFormat format, Fox::Core::BlockFormat& blockFormat) {
+            switch (format) {
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+                blockFormat = Fox::Core::BlockFormat::BC1;
+                return true;
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+                blockFormat = Fox::Core::BlockFormat::BC3;
+                return true;
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                blockFormat = Fox::Core::BlockFormat::BC5;
+                return true;
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+                blockFormat = Fox::Core::BlockFormat::BC7;
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        VkFormat TextureManager::GetFallbackFormat(VkFormat format) {
+            switch (format) {
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return VK_FORMAT_R8G8B8A8_SRGB;
+            default:
+                return VK_FORMAT_R8G8B8A8_UNORM;
+            }
+        }
+
+        bool TextureManager::IsSrgbFormat(VkFormat format) {
+            switch (format) {
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        bool TextureManager::IsFormatSupported(VkFormat format) {
             Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
 
-            int texWidth, texHeight, texChannels;
-            stbi_uc* pixels = stbi_load(TEXTURE_PATH.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-            VkDeviceSize imageSize = texWidth * texHeight * 4;
+            if (!renderer->GetEnabledFeatures().textureCompressionBC) {
+                return false;
+            }
 
-            mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
+            VkFormatProperties formatProperties;
+            vkGetPhysicalDeviceFormatProperties(renderer->physicalDevice, format, &formatProperties);
+            return (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+        }
 
-            if (!pixels) {
-                throw std::runtime_error("Failed to load texture image!");
+        Fox::Vulkan::Texture* TextureManager::Acquire(const std::string& path, VkFormat format) {
+            std::string key = GetKey(path, format);
+
+            auto it = textures.find(key);
+            if (it == textures.end()) {
+                CacheEntry entry;
+                LoadTexture(path, format, entry);
+                textureKeys[entry.texture.get()] = key;
+                it = textures.emplace(key, std::move(entry)).first;
             }
 
-            Fox::Vulkan::Buffer<unsigned char*> stagingBuffer;
+            // a pending release is cancelled simply by the count being non-zero again
+            it->second.referenceCount++;
+            return it->second.texture.get();
+        }
 
-            stagingBuffer.Create(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        void TextureManager::Release(const std::string& path, VkFormat format) {
+            std::string key = GetKey(path, format);
 
-            stagingBuffer.CopyImage(imageSize, pixels);
+            auto it = textures.find(key);
+            if (it == textures.end() || it->second.referenceCount == 0u) {
+                std::cout << "Warning: releasing texture " << key << " that is not acquired." << std::endl;
+                return;
+            }
 
-            stbi_image_free(pixels);
-            
-            texture = std::make_shared<Fox::Vulkan::Texture>(texWidth, texHeight, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_SRGB,
-                VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_COLOR_BIT);
+            if (--it->second.referenceCount == 0u) {
+                it->second.releaseFrame = Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber();
+                pendingReleases.push_back(key);
+            }
+        }
 
-            renderer->TransitionImageLayout(texture->GetImage(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
-            renderer->CopyBufferToImage(stagingBuffer.GetBuffer(), texture->GetImage(), static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
-            GenerateMipmaps(texture->GetImage(), VK_FORMAT_R8G8B8A8_SRGB, texWidth, texHeight, mipLevels);
+        void TextureManager::CollectGarbage(uint64_t frameNumber) {
+            for (auto it = pendingReleases.begin(); it != pendingReleases.end();) {
+                auto entry = textures.find(*it);
+
+                if (entry == textures.end() || entry->second.referenceCount > 0u) {
+                    it = pendingReleases.erase(it);
+                    continue;
+                }
+
+                // a resize in flight still has to land in the entry
+                if (frameNumber < entry->second.releaseFrame + numFramesInFlight || entry->second.pendingLevel != ~0u) {
+                    ++it;
+                    continue;
+                }
+
+                streamingStatistics.residentBytes -= entry->second.texture->GetMemorySize();
+                textureKeys.erase(entry->second.texture.get());
+                DestroyTexture(entry->second.texture);
+                textures.erase(entry);
+                it = pendingReleases.erase(it);
+            }
+
+            retiredTextures.erase(std::remove_if(retiredTextures.begin(), retiredTextures.end(),
+                [this, frameNumber](const std::pair<uint64_t, std::shared_ptr<Fox::Vulkan::Texture>>& retired) {
+                    return frameNumber >= retired.first + numFramesInFlight;
+                }), retiredTextures.end());
+        }
+
+        uint32_t TextureManager::GetMaxMipLevels() {
+            VkPhysicalDeviceProperties properties{};
+            vkGetPhysicalDeviceProperties(Fox::Vulkan::Renderer::GetRenderer()->physicalDevice, &properties);
+            return static_cast<uint32_t>(std::floor(std::log2(properties.limits.maxImageDimension2D))) + 1;
+        }
+
+        void TextureManager::DestroyTexture(std::shared_ptr<Fox::Vulkan::Texture>& texture) {
+            if (!texture) {
+                return;
+            }
+
+            Fox::Vulkan::DescriptorSetManager* descriptorManager = Fox::Vulkan::Renderer::GetRenderer()->GetDesciptorManager();
+            if (descriptorManager) {
+                descriptorManager->ReleaseDescriptorSets(texture.get());
+            }
+            texture = nullptr;
         }
 
-        void TextureManager::GenerateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels) {
+        void TextureManager::RequestScreenSize(Fox::Vulkan::Texture* texture, float pixels) {
+            auto key = textureKeys.find(texture);
+            if (key == textureKeys.end() || pixels <= 0.0f) {
+                return;
+            }
+
+            CacheEntry& entry = textures[key->second];
+            const Fox::Core::TextureLevel& top = entry.container.levels[0];
+
+            // assumes the texture is stretched once across the object, one texel per pixel is enough
+            float texels = static_cast<float>(std::max(top.width, top.height));
+            uint32_t maxLevel = static_cast<uint32_t>(entry.container.levels.size()) - 1u;
+            uint32_t level = pixels >= texels ? 0u : std::min(static_cast<uint32_t>(std::log2(texels / pixels)), maxLevel);
+
+            entry.requestedLevel = std::min(entry.requestedLevel, level);
+            entry.lastRequestFrame = Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber();
+        }
+
+        void TextureManager::UpdateStreaming() {
+            const Fox::Vulkan::RendererConfig& config = Fox::Vulkan::Renderer::GetRenderer()->GetConfig();
+
+            streamingStatistics.budgetBytes = config.textureBudget;
+            streamingStatistics.pendingRequests = 0u;
+            streamingStatistics.uploads = 0u;
+            streamingStatistics.evictions = 0u;
+
+            if (!config.textureStreaming) {
+                return;
+            }
+
+            // the textures missing the most levels go first
+            std::vector<CacheEntry*> requests;
+            for (auto& texture : textures) {
+                if (texture.second.requestedLevel < texture.second.residentLevel && texture.second.pendingLevel == ~0u) {
+                    requests.push_back(&texture.second);
+                }
+            }
+
+            std::sort(requests.begin(), requests.end(), [](const CacheEntry* a, const CacheEntry* b) {
+                return a->residentLevel - a->requestedLevel > b->residentLevel - b->requestedLevel;
+            });
+
+            for (CacheEntry* entry : requests) {
+                if (streamingStatistics.uploads >= config.textureUploadsPerFrame) {
+                    streamingStatistics.pendingRequests++;
+                    continue;
+                }
+
+                uint64_t bytes = GetLevelBytes(entry->container, entry->requestedLevel) - GetLevelBytes(entry->container, entry->residentLevel);
+                if (!MakeRoom(bytes, *entry)) {
+                    streamingStatistics.pendingRequests++;
+                    continue;
+                }
+
+                ResizeTexture(*entry, entry->requestedLevel);
+                streamingStatistics.uploads++;
+            }
+
+            for (auto& texture : textures) {
+                texture.second.requestedLevel = ~0u;
+            }
+        }
+
+        bool TextureManager::MakeRoom(uint64_t bytes, const CacheEntry& requester) {
+            uint64_t budget = Fox::Vulkan::Renderer::GetRenderer()->GetConfig().textureBudget;
+
+            while (streamingStatistics.residentBytes + bytes > budget) {
+                // least recently needed first, a texture only gives up the levels finer than what it asked for last frame
+                CacheEntry* victim = nullptr;
+                uint32_t victimLevel = 0u;
+
+                for (auto& texture : textures) {
+                    CacheEntry& entry = texture.second;
+                    uint32_t neededLevel = std::min(entry.requestedLevel, entry.tailLevel);
+
+                    if (&entry == &requester || neededLevel <= entry.residentLevel || entry.pendingLevel != ~0u) {
+                        continue;
+                    }
+
+                    if (!victim || entry.lastRequestFrame < victim->lastRequestFrame) {
+                        victim = &entry;
+                        victimLevel = neededLevel;
+                    }
+                }
+
+                if (!victim) {
+                    return false;
+                }
+
+                ResizeTexture(*victim, victimLevel);
+                streamingStatistics.evictions++;
+                streamingStatistics.totalEvictions++;
+            }
+
+            return true;
+        }
+
+        void TextureManager::ResizeTexture(CacheEntry& entry, uint32_t level) {
+            Fox::Vulkan::Texture* target = entry.texture.get();
+
+            // the budget counts the new size from now on, the exact one is known once the image exists
+            entry.pendingLevel = level;
+            entry.pendingBytes = GetLevelBytes(entry.container, level);
+            streamingStatistics.residentBytes -= entry.texture->GetMemorySize();
+            streamingStatistics.residentBytes += entry.pendingBytes;
+
+            // uploaded on the transfer queue like any streamed texture, the frame keeps sampling the current image until then
+            Fox::Vulkan::Renderer::GetRenderer()->GetStreamingManager()->RequestResize(textureKeys[target], entry.container, level,
+                [this, target](std::shared_ptr<Fox::Vulkan::Texture> texture) {
+                    FinishResize(target, texture);
+                });
+        }
+
+        void TextureManager::FinishResize(Fox::Vulkan::Texture* target, std::shared_ptr<Fox::Vulkan::Texture> texture) {
+            // garbage collection waits for the resize, so the entry is still there
+            CacheEntry& entry = textures[textureKeys[target]];
+            streamingStatistics.residentBytes -= entry.pendingBytes;
+
+            if (texture) {
+                streamingStatistics.residentBytes += texture->GetMemorySize();
+
+                // the cached texture keeps its identity, the old image moves into the retired one
+                entry.texture->Swap(*texture);
+                entry.residentLevel = entry.pendingLevel;
+                retiredTextures.push_back({ Fox::Vulkan::Renderer::GetRenderer()->GetFrameNumber(), texture });
+            } else {
+                streamingStatistics.residentBytes += entry.texture->GetMemorySize();
+            }
+
+            entry.pendingLevel = ~0u;
+            entry.pendingBytes = 0u;
+        }
+
+        void TextureManager::Defragment(uint64_t frameNumber) {
             Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            Fox::Vulkan::MemoryAllocator* memoryAllocator = renderer->GetMemoryAllocator();
+            uint64_t budget = renderer->GetConfig().defragmentBytesPerFrame;
 
-            VkFormatProperties formatProperties;
-            vkGetPhysicalDeviceFormatProperties(renderer->physicalDevice, imageFormat, &formatProperties);
+            if (budget == 0u || !memoryAllocator->BeginEvacuation()) {
+                return;
+            }
 
-            if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
-                throw std::runtime_error("Texture image format does not support linear blitting!");
+            std::vector<std::shared_ptr<Fox::Vulkan::Texture>*> candidates;
+            for (auto& texture : textures) {
+                // a resize in flight replaces the image anyway
+                if (texture.second.pendingLevel == ~0u) {
+                    candidates.push_back(&texture.second.texture);
+                }
             }
+            candidates.push_back(&defaultTexture);
 
-            VkCommandBuffer commandBuffer = renderer->BeginSingleTimeCommands();
+            std::vector<std::shared_ptr<Fox::Vulkan::Texture>> streamedTextures = renderer->GetStreamingManager()->GetResidentTextures();
+            for (std::shared_ptr<Fox::Vulkan::Texture>& texture : streamedTextures) {
+                candidates.push_back(&texture);
+            }
 
-            VkImageMemoryBarrier barrier{};
-            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-            barrier.image = image;
-            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            barrier.subresourceRange.baseArrayLayer = 0;
-            barrier.subresourceRange.layerCount = 1;
-            barrier.subresourceRange.levelCount = 1;
+            uint64_t movedBytes = 0u;
+            bool remaining = false;
+            for (std::shared_ptr<Fox::Vulkan::Texture>* texture : candidates) {
+                if (!memoryAllocator->IsEvacuating((*texture)->GetAllocation())) {
+                    continue;
+                }
+
+                // a texture larger than the budget still moves, alone in its frame
+                if (movedBytes > 0u && movedBytes + (*texture)->GetMemorySize() > budget) {
+                    remaining = true;
+                    break;
+                }
+
+                movedBytes += (*texture)->GetMemorySize();
+                MoveTexture(*texture, frameNumber);
+            }
 
-            int32_t mipWidth = texWidth;
-            int32_t mipHeight = texHeight;
+            if (movedBytes > 0u || remaining) {
+                return;
+            }
 
-            for (uint32_t i = 1; i < mipLevels; i++) {
+            // the old images wait for the frames in flight and streamed images become candidates once they are resident,
+            // anything else left in the block is not ours to move
+            bool retiring = std::any_of(retiredTextures.begin(), retiredTextures.end(),
+                [memoryAllocator](const std::pair<uint64_t, std::shared_ptr<Fox::Vulkan::Texture>>& retired) {
+                    return memoryAllocator->IsEvacuating(retired.second->GetAllocation());
+                });
+            bool streaming = renderer->GetStreamingManager()->GetStatistics().pendingTextures > 0u;
+            if (!retiring && !streaming) {
+                memoryAllocator->CancelEvacuation();
+            }
+        }
 
-                int32_t targetMipWidth = mipWidth > 1 ? mipWidth >> 1 : 1;
-                int32_t targetMipHeight = mipHeight > 1 ? mipHeight >> 1 : 1;
+        void TextureManager::MoveTexture(std::shared_ptr<Fox::Vulkan::Texture>& texture, uint64_t frameNumber) {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
 
-                barrier.srcAccessMask = VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT;
-                barrier.dstAccessMask = VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT;
-                barrier.subresourceRange.baseMipLevel = i - 1;
-                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            // the allocator keeps new allocations out of the evacuated block
+            std::shared_ptr<Fox::Vulkan::Texture> moved = std::make_shared<Fox::Vulkan::Texture>(texture->GetWidth(), texture->GetHeight(), texture->GetMipLevels(),
+                VK_SAMPLE_COUNT_1_BIT, texture->GetFormat(), VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_COLOR_BIT, texture->GetArrayLayers());
 
-                vkCmdPipelineBarrier(commandBuffer, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
-                    VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+            renderer->GetMemoryAllocator()->RecordMove(texture->GetMemorySize());
 
-                VkImageBlit blit{};
-                blit.srcOffsets[0] = { 0, 0, 0 };
-                blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
-                blit.srcSubresource.aspectMask = VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
-                blit.srcSubresource.baseArrayLayer = 0;
-                blit.srcSubresource.layerCount = 1;
-                blit.srcSubresource.mipLevel = i - 1;
+            // same identity as for a resize, the version bump has the descriptor sets and bindless slots rewritten. The frame
+            // samples the new image only after RecordMoves has copied into it, the old one retires with that frame.
+            texture->Swap(*moved);
+            retiredTextures.push_back({ frameNumber, moved });
+            pendingMoves.push_back({ moved, texture });
+        }
 
-                blit.dstOffsets[0] = { 0, 0, 0 };
-                blit.dstOffsets[1] = { targetMipWidth, targetMipHeight, 1 };
-                blit.dstSubresource.aspectMask = VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT;
-                blit.dstSubresource.baseArrayLayer = 0;
-                blit.dstSubresource.layerCount = 1;
-                blit.dstSubresource.mipLevel = i;
+        void TextureManager::RecordMoves(VkCommandBuffer commandBuffer) {
+            if (pendingMoves.empty()) {
+                return;
+            }
 
+            std::vector<VkImageMemoryBarrier> barriers;
+            for (TextureMove& move : pendingMoves) {
+                VkImageMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                barrier.subresourceRange.baseMipLevel = 0;
+                barrier.subresourceRange.levelCount = move.target->GetMipLevels();
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount = move.target->GetArrayLayers();
+
+                // the old image may still be sampled by earlier frames on this queue
+                barrier.image = move.source->GetImage();
+                barrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                barriers.push_back(barrier);
+
+                barrier.image = move.target->GetImage();
+                barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barriers.push_back(barrier);
+            }
 
-                vkCmdBlitImage(commandBuffer, image, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                    image, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VkFilter::VK_FILTER_LINEAR);
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            for (TextureMove& move : pendingMoves) {
+                Fox::Vulkan::Texture* target = move.target.get();
+
+                std::vector<VkImageCopy> regions(target->GetMipLevels());
+                for (uint32_t i = 0; i < regions.size(); i++) {
+                    VkImageCopy& region = regions[i];
+                    region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                    region.srcSubresource.mipLevel = i;
+                    region.srcSubresource.baseArrayLayer = 0;
+                    region.srcSubresource.layerCount = target->GetArrayLayers();
+                    region.dstSubresource = region.srcSubresource;
+                    region.extent = { std::max(target->GetWidth() >> i, 1u), std::max(target->GetHeight() >> i, 1u), 1 };
+                }
+
+                vkCmdCopyImage(commandBuffer, move.source->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, target->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    static_cast<uint32_t>(regions.size()), regions.data());
+            }
 
-                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            // the old images stay as they are until they retire, only the new ones are sampled from here on
+            barriers.clear();
+            for (TextureMove& move : pendingMoves) {
+                VkImageMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image = move.target->GetImage();
+                barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
                 barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
                 barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+                barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                barrier.subresourceRange.baseMipLevel = 0;
+                barrier.subresourceRange.levelCount = move.target->GetMipLevels();
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount = move.target->GetArrayLayers();
+                barriers.push_back(barrier);
+            }
+
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                static_cast<uint32_t>(barriers.size()), barriers.data());
+
+            pendingMoves.clear();
+        }
+
+        uint64_t TextureManager::GetLevelBytes(const Fox::Core::TextureContainer& container, uint32_t firstLevel) {
+            uint64_t bytes = 0u;
+            for (size_t i = firstLevel; i < container.levels.size(); i++) {
+                bytes += container.levels[i].size;
+            }
+            return bytes;
+        }
+
+        VkFormat TextureManager::ResolveFormat(const std::string& path, VkFormat format) {
+            Fox::Core::BlockFormat blockFormat;
+            if (GetBlockFormat(format, blockFormat)) {
+                if (!IsFormatSupported(format)) {
+                    std::cout << "Warning: block compressed format " << format << " not supported, loading " << path << " uncompressed." << std::endl;
+                    return GetFallbackFormat(format);
+                }
+            } else if (format != VK_FORMAT_R8G8B8A8_SRGB && format != VK_FORMAT_R8G8B8A8_UNORM) {
+                throw std::runtime_error("Unsupported texture format for " + path + "!");
+            }
+            return format;
+        }
+
+        uint32_t TextureManager::GetTailLevel(const Fox::Core::TextureContainer& container, uint32_t tailSize) {
+            // the tail is the first level small enough to always stay resident
+            for (uint32_t i = 0u; i < container.levels.size(); i++) {
+                const Fox::Core::TextureLevel& level = container.levels[i];
+                if (std::max(level.width, level.height) <= tailSize) {
+                    return i;
+                }
+            }
+            return static_cast<uint32_t>(container.levels.size()) - 1u;
+        }
+
+        void TextureManager::LoadTexture(const std::string& path, VkFormat format, CacheEntry& entry) {
+            format = ResolveFormat(path, format);
+
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+            const Fox::Vulkan::RendererConfig& config = renderer->GetConfig();
+
+            entry.container = LoadContainer(path, format, renderer->GetThreadPool());
+            entry.tailLevel = GetTailLevel(entry.container, config.textureTailSize);
+            entry.residentLevel = config.textureStreaming ? entry.tailLevel : 0u;
+            entry.texture = CreateTexture(entry.container, entry.residentLevel);
+            streamingStatistics.residentBytes += entry.texture->GetMemorySize();
+        }
+
+        std::vector<Fox::Vulkan::Texture*> TextureManager::Preload(const std::vector<std::string>& paths, VkFormat format) {
+            const Fox::Vulkan::RendererConfig& config = Fox::Vulkan::Renderer::GetRenderer()->GetConfig();
+
+            std::vector<Fox::Vulkan::TextureImport> imports;
+            std::unordered_map<std::string, size_t> importKeys;
+
+            for (const std::string& path : paths) {
+                std::string key = GetKey(path, format);
+                if (textures.count(key) || importKeys.count(key)) {
+                    continue;
+                }
+
+                Fox::Vulkan::TextureImport import;
+                import.path = path;
+                import.format = ResolveFormat(path, format);
+                importKeys[key] = imports.size();
+                imports.push_back(std::move(import));
+            }
+
+            if (!imports.empty()) {
+                Fox::Vulkan::TextureImporter importer(config.importStagingSize);
+
+                uint32_t tailSize = config.textureTailSize;
+                bool streaming = config.textureStreaming;
+                importer.Import(imports, [tailSize, streaming](const Fox::Core::TextureContainer& container) {
+                    return streaming ? GetTailLevel(container, tailSize) : 0u;
+                });
+
+                for (auto& importKey : importKeys) {
+                    Fox::Vulkan::TextureImport& import = imports[importKey.second];
+                    if (!import.texture) {
+                        continue;
+                    }
+
+                    CacheEntry entry;
+                    entry.tailLevel = GetTailLevel(import.container, tailSize);
+                    entry.residentLevel = import.firstLevel;
+                    entry.container = std::move(import.container);
+                    entry.texture = import.texture;
+                    streamingStatistics.residentBytes += entry.texture->GetMemorySize();
+
+                    textureKeys[entry.texture.get()] = importKey.first;
+                    textures.emplace(importKey.first, std::move(entry));
+                }
+
+                const Fox::Vulkan::TextureImportStatistics& statistics = importer.GetStatistics();
+                std::cout << "Imported " << statistics.textures << " textures (" << statistics.failed << " failed, "
+                    << static_cast<double>(statistics.uploadedBytes) / (1024.0 * 1024.0) << " MB) in " << statistics.seconds << " s: "
+                    << statistics.GetMegabytesPerSecond() << " MB/s, " << statistics.GetTexturesPerSecond() << " textures/s on "
+                    << Fox::Vulkan::Renderer::GetRenderer()->GetThreadPool()->GetThreadCount() << " threads" << std::endl;
+            }
+
+            std::vector<Fox::Vulkan::Texture*> acquired;
+            acquired.reserve(paths.size());
 
-                vkCmdPipelineBarrier(commandBuffer,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-                    0, nullptr,
-                    0, nullptr,
-                    1, &barrier);
+            for (const std::string& path : paths) {
+                auto it = textures.find(GetKey(path, format));
+                if (it == textures.end()) {
+                    acquired.push_back(nullptr);
+                    continue;
+                }
 
-                if (mipWidth > 1) mipWidth >>= 1;
-                if (mipHeight > 1) mipHeight >>= 1;
+                it->second.referenceCount++;
+                acquired.push_back(it->second.texture.get());
             }
 
-            barrier.subresourceRange.baseMipLevel = mipLevels - 1;
-            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            return acquired;
+        }
+
+        Fox::Core::TextureContainer TextureManager::LoadContainer(const std::string& path, VkFormat format, Fox::Core::ThreadPool* threadPool, Fox::Core::MipFilter filter) {
+            Fox::Core::TextureContainer container;
+
+            // shipped containers are used as they are, whatever format they were cooked to
+            const std::string& extension = Fox::Core::TextureContainer::EXTENSION;
+            if (path.size() > extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+                if (!container.Map(path)) {
+                    throw std::runtime_error("Failed to map texture container " + path + "!");
+                }
+                return container;
+            }
+
+            // the filter is part of the name so containers cooked with different filters live side by side, the header check catches renamed files
+            std::string cachePath = CACHE_DIRECTORY + GetCachePath(path, format, filter);
+            if (Fox::Core::TextureContainer::IsUpToDate(cachePath, path) && container.Map(cachePath) && container.format == static_cast<uint32_t>(format) &&
+                container.mipFilter == static_cast<uint32_t>(filter)) {
+                return container;
+            }
 
-            vkCmdPipelineBarrier(commandBuffer,
-                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-                0, nullptr,
-                0, nullptr,
-                1, &barrier);
+            container = CookTexture(path, format, threadPool, filter);
+            container.Write(cachePath);
+
+            // hand out the mapping when possible so the cooked pixels do not stay on the heap
+            Fox::Core::TextureContainer mapped;
+            if (mapped.Map(cachePath)) {
+                return mapped;
+            }
+            return container;
+        }
+
+        Fox::Core::TextureContainer TextureManager::CookTexture(const std::string& path, VkFormat format, Fox::Core::ThreadPool* threadPool, Fox::Core::MipFilter filter) {
+            int texWidth, texHeight, texChannels;
+            stbi_uc* pixels = stbi_load(path.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+
+            if (!pixels) {
+                throw std::runtime_error("Failed to load texture image!");
+            }
+
+            std::vector<std::vector<Fox::Core::MipImage>> layers(1);
+            layers[0] = Fox::Core::MipGenerator::Generate(pixels, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight),
+                filter, IsSrgbFormat(format), threadPool);
+            stbi_image_free(pixels);
+
+            Fox::Core::TextureContainer container = CookLayers(layers, format, threadPool);
+            container.mipFilter = static_cast<uint32_t>(filter);
+            return container;
+        }
+
+        Fox::Core::TextureContainer TextureManager::CookLayers(const std::vector<std::vector<Fox::Core::MipImage>>& layers, VkFormat format, Fox::Core::ThreadPool* threadPool) {
+            if (layers.empty() || layers[0].empty()) {
+                throw std::runtime_error("Failed to cook texture without layers!");
+            }
 
+            const std::vector<Fox::Core::MipImage>& first = layers[0];
+            for (const std::vector<Fox::Core::MipImage>& chain : layers) {
+                if (chain.size() != first.size() || chain[0].width != first[0].width || chain[0].height != first[0].height) {
+                    throw std::runtime_error("Failed to cook texture layers of different sizes!");
+                }
+            }
+
+            Fox::Core::BlockFormat blockFormat;
+            bool compressed = GetBlockFormat(format, blockFormat);
+            uint64_t layerCount = layers.size();
+
+            Fox::Core::TextureContainer container;
+            container.format = static_cast<uint32_t>(format);
+            container.width = first[0].width;
+            container.height = first[0].height;
+            container.layerCount = static_cast<uint32_t>(layerCount);
+
+            uint64_t offset = 0u;
+            for (const Fox::Core::MipImage& image : first) {
+                Fox::Core::TextureLevel level;
+                level.width = image.width;
+                level.height = image.height;
+                level.offset = Fox::Core::TextureContainer::AlignLevelOffset(offset);
+                level.size = layerCount * (compressed ? Fox::Core::BlockCompression::GetCompressedSize(blockFormat, image.width, image.height) : image.pixels.size());
+                container.levels.push_back(level);
+                offset = level.offset + level.size;
+            }
+
+            container.data.resize(offset);
+            for (size_t i = 0u; i < first.size(); i++) {
+                const Fox::Core::TextureLevel& level = container.levels[i];
+                uint64_t layerSize = level.size / layerCount;
+
+                for (size_t layer = 0u; layer < layers.size(); layer++) {
+                    uint8_t* target = &container.data[level.offset + layer * layerSize];
+
+                    if (compressed) {
+                        Fox::Core::BlockCompression::CompressTo(blockFormat, layers[layer][i].pixels.data(), level.width, level.height, target, threadPool);
+                    } else {
+                        memcpy(target, layers[layer][i].pixels.data(), layerSize);
+                    }
+                }
+            }
+
+            return container;
+        }
+
+        std::shared_ptr<Fox::Vulkan::Texture> TextureManager::CreateTexture(const Fox::Core::TextureContainer& container, uint32_t firstLevel) {
+            Fox::Vulkan::Renderer* renderer = Fox::Vulkan::Renderer::GetRenderer();
+
+            // levels are stored finest first, so the levels from firstLevel on are one contiguous range
+            const Fox::Core::TextureLevel& top = container.levels[firstLevel];
+            VkFormat format = static_cast<VkFormat>(container.format);
+            VkDeviceSize imageSize = static_cast<VkDeviceSize>(container.GetDataSize() - top.offset);
+            uint32_t mipLevels = static_cast<uint32_t>(container.levels.size()) - firstLevel;
+            uint32_t layerCount = container.layerCount;
+
+            Fox::Vulkan::StagingAllocation staging = renderer->GetStagingPool()->Allocate(imageSize);
+
+            // for a mapped container this is the only time the file pages are read
+            memcpy(staging.data, container.GetData() + top.offset, imageSize);
+
+            std::shared_ptr<Fox::Vulkan::Texture> texture = std::make_shared<Fox::Vulkan::Texture>(top.width, top.height, mipLevels, VK_SAMPLE_COUNT_1_BIT, format,
+                VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_IMAGE_ASPECT_COLOR_BIT, layerCount);
+
+            std::vector<VkBufferImageCopy> regions(mipLevels);
+            for (uint32_t i = 0; i < mipLevels; i++) {
+                const Fox::Core::TextureLevel& level = container.levels[firstLevel + i];
+
+                VkBufferImageCopy& region = regions[i];
+                region.bufferOffset = staging.offset + level.offset - top.offset;
+                region.bufferRowLength = 0;
+                region.bufferImageHeight = 0;
+                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.imageSubresource.mipLevel = i;
+                region.imageSubresource.baseArrayLayer = 0;
+                region.imageSubresource.layerCount = layerCount;
+                region.imageOffset = { 0, 0, 0 };
+                region.imageExtent = { level.width, level.height, 1 };
+            }
+
+            // both transitions and the copy go into one submission, which is waited for once
+            VkCommandBuffer commandBuffer = renderer->BeginSingleTimeCommands();
+            renderer->TransitionImageLayout(commandBuffer, texture->GetImage(), format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, layerCount);
+            renderer->CopyBufferToImage(commandBuffer, staging.buffer, texture->GetImage(), regions);
+            renderer->TransitionImageLayout(commandBuffer, texture->GetImage(), format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels,
+                layerCount);
             renderer->EndSingleTimeCommands(commandBuffer);
+            renderer->GetStagingPool()->Free(staging);
+
+            return texture;
         }
 	}
-}
\ No newline at end of file
+}
@@ -4,28 +4,134 @@ namespace Fox {
 
 	namespace Vulkan {
 
+		struct TextureStreamingStatistics {
+			uint64_t residentBytes = 0u;
+			uint64_t budgetBytes = 0u;
+			uint32_t pendingRequests = 0u;	// wanted a finer level last frame but did not get it
+			uint32_t uploads = 0u;			// per frame
+			uint32_t evictions = 0u;		// per frame
+			uint64_t totalEvictions = 0u;
+		};
+
+		// Texture cache keyed by path and format. Textures are loaded on first Acquire and reference counted,
+		// a texture whose count drops to zero is destroyed only once every frame in flight that may still sample it has finished.
+		// Every texture is cooked once on the CPU, full mip chain and block compression included, into the cache directory
+		// and uploaded with a single copy. Devices without BC support get the uncompressed RGBA8 equivalent instead.
+		// With streaming enabled a texture starts with only its mip tail resident, finer levels follow the on-screen size
+		// reported each frame and the least recently needed levels are dropped again when the budget runs out. Resized images
+		// are uploaded by the streaming manager and swapped in once they are resident.
 		class TextureManager {
 
 		public:
 
 			TextureManager() = default;
+			TextureManager(uint32_t numFramesInFlight);
 			~TextureManager();
 
-			VkImageView GetImageViewForTexture() {
-				return texture->GetImageView();
+			void CreateTextures();
+
+			Fox::Vulkan::Texture* Acquire(const std::string& path, VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+			void Release(const std::string& path, VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+			// acquires every path at once, decoding in parallel and uploading while decoding, failed textures come back as null
+			std::vector<Fox::Vulkan::Texture*> Preload(const std::vector<std::string>& paths, VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+			// destroys released textures that are no longer referenced by a frame in flight
+			void CollectGarbage(uint64_t frameNumber);
+
+			// asks for enough detail to cover the given height in pixels, the finest request of a frame wins
+			void RequestScreenSize(Fox::Vulkan::Texture* texture, float pixels);
+			// requests resizes towards last frame's requests within the budget, once per frame before recording
+			void UpdateStreaming();
+			// moves textures out of the memory block being evacuated within the per-frame byte budget, once per frame before recording
+			void Defragment(uint64_t frameNumber);
+			// records the copies of this frame's moves, must be outside of a render pass
+			void RecordMoves(VkCommandBuffer commandBuffer);
+
+			inline const Fox::Vulkan::TextureStreamingStatistics& GetStreamingStatistics() const {
+				return streamingStatistics;
 			}
-			void CreateTextures(uint32_t mipLevels);
+
+			inline Fox::Vulkan::Texture* GetDefaultTexture() {
+				return defaultTexture.get();
+			}
+
+			inline size_t GetTextureCount() const {
+				return textures.size();
+			}
+
+			// upper bound for the mip chain of any texture the device can create
+			uint32_t GetMaxMipLevels();
+
+			// reads the cooked container for path and format, cooking it first when missing or stale, safe to call from worker threads
+			static Fox::Core::TextureContainer LoadContainer(const std::string& path, VkFormat format, Fox::Core::ThreadPool* threadPool,
+				Fox::Core::MipFilter filter = Fox::Core::MipFilter::Kaiser);
+			static Fox::Core::TextureContainer CookTexture(const std::string& path, VkFormat format, Fox::Core::ThreadPool* threadPool,
+				Fox::Core::MipFilter filter = Fox::Core::MipFilter::Kaiser);
+			// packs equally sized mip chains into the layers of one container, compressing them when the format is block compressed
+			static Fox::Core::TextureContainer CookLayers(const std::vector<std::vector<Fox::Core::MipImage>>& layers, VkFormat format,
+				Fox::Core::ThreadPool* threadPool);
+
+			static bool GetBlockFormat(VkFormat format, Fox::Core::BlockFormat& blockFormat);
+			static bool IsSrgbFormat(VkFormat format);
+			// the format actually cooked for a requested one, throws for formats that cannot be loaded
+			VkFormat ResolveFormat(const std::string& path, VkFormat format);
+
+			// uploads the levels from firstLevel on with a single copy, firstLevel becomes mip 0 of the texture
+			std::shared_ptr<Fox::Vulkan::Texture> CreateTexture(const Fox::Core::TextureContainer& container, uint32_t firstLevel = 0u);
+			void DestroyTexture(std::shared_ptr<Fox::Vulkan::Texture>& texture);
 
 		private:
 
-			const std::string TEXTURE_PATH = "textures/viking.png";
+			struct CacheEntry {
+				std::shared_ptr<Fox::Vulkan::Texture> texture;
+				uint32_t referenceCount = 0u;
+				uint64_t releaseFrame = 0u;
+
+				// mapped source of every re-upload
+				Fox::Core::TextureContainer container;
+				uint32_t residentLevel = 0u;
+				uint32_t tailLevel = 0u;
+				uint32_t requestedLevel = ~0u;
+				uint64_t lastRequestFrame = 0u;
+
+				uint32_t pendingLevel = ~0u;	// a resize to this level is on its way
+				uint64_t pendingBytes = 0u;		// its expected size, counted as resident until it arrives
+			};
+
+			static std::string GetKey(const std::string& path, VkFormat format);
+			static std::string GetCachePath(const std::string& path, VkFormat format, Fox::Core::MipFilter filter);
+			static VkFormat GetFallbackFormat(VkFormat format);
+
+			bool IsFormatSupported(VkFormat format);
+			static uint32_t GetTailLevel(const Fox::Core::TextureContainer& container, uint32_t tailSize);
+
+			void LoadTexture(const std::string& path, VkFormat format, CacheEntry& entry);
+
+			void ResizeTexture(CacheEntry& entry, uint32_t level);
+			void FinishResize(Fox::Vulkan::Texture* target, std::shared_ptr<Fox::Vulkan::Texture> texture);
+			void MoveTexture(std::shared_ptr<Fox::Vulkan::Texture>& texture, uint64_t frameNumber);
+			bool MakeRoom(uint64_t bytes, const CacheEntry& requester);
+			static uint64_t GetLevelBytes(const Fox::Core::TextureContainer& container, uint32_t firstLevel);
+
+			struct TextureMove {
+				std::shared_ptr<Fox::Vulkan::Texture> source;	// holds the old image, retired
+				std::shared_ptr<Fox::Vulkan::Texture> target;
+			};
 
+			static const std::string CACHE_DIRECTORY;
 
-			void GenerateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
+			uint32_t numFramesInFlight = 2u;
 
-			std::shared_ptr<Fox::Vulkan::Texture> texture;
+			std::unordered_map<std::string, CacheEntry> textures;
+			std::unordered_map<Fox::Vulkan::Texture*, std::string> textureKeys;
+			std::vector<std::string> pendingReleases;
+			// images replaced by a resize or a move, kept until the frames that sampled them have finished
+			std::vector<std::pair<uint64_t, std::shared_ptr<Fox::Vulkan::Texture>>> retiredTextures;
+			// copies recorded into the next frame's command buffer, the old images retire with that frame
+			std::vector<TextureMove> pendingMoves;
 
+			Fox::Vulkan::TextureStreamingStatistics streamingStatistics;
 
+			std::shared_ptr<Fox::Vulkan::Texture> defaultTexture;
 		};
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,65 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		UploadRing::UploadRing(VkDeviceSize partitionSize, uint32_t numFramesInFlight) {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(Fox::Vulkan::Renderer::GetRenderer()->physicalDevice, &properties);
+            uniformAlignment = properties.limits.minUniformBufferOffsetAlignment;
+            storageAlignment = properties.limits.minStorageBufferOffsetAlignment;
+
+            // every partition starts on an offset any kind of binding accepts
+            VkDeviceSize alignment = std::max(uniformAlignment, storageAlignment);
+            this->partitionSize = (partitionSize + alignment - 1u) / alignment * alignment;
+
+            buffer = std::make_unique<Fox::Vulkan::Buffer<unsigned char>>();
+            buffer->Create(this->partitionSize * numFramesInFlight, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            mappedMemory = static_cast<uint8_t*>(buffer->GetMappedMemory());
+		}
+
+        void UploadRing::BeginFrame(uint32_t frameIndex) {
+            statistics.peakBytes = std::max(statistics.peakBytes, statistics.usedBytes);
+            statistics.usedBytes = 0u;
+
+            this->frameIndex = frameIndex;
+            head = 0u;
+            overflowReported = false;
+        }
+
+        Fox::Vulkan::UploadAllocation UploadRing::Allocate(VkDeviceSize size, VkDeviceSize alignment) {
+            alignment = std::max<VkDeviceSize>(alignment, 1u);
+            VkDeviceSize offset = (head + alignment - 1u) / alignment * alignment;
+
+            if (size == 0u || offset + size > partitionSize) {
+                statistics.failedAllocations++;
+                if (!overflowReported && size > 0u) {
+                    std::cout << "Warning: upload ring partition of " << partitionSize << " bytes is full." << std::endl;
+                    overflowReported = true;
+                }
+                return Fox::Vulkan::UploadAllocation();
+            }
+
+            head = offset + size;
+            statistics.usedBytes = head;
+
+            Fox::Vulkan::UploadAllocation allocation;
+            allocation.buffer = buffer->GetBuffer();
+            allocation.offset = static_cast<VkDeviceSize>(frameIndex) * partitionSize + offset;
+            allocation.size = size;
+            allocation.data = mappedMemory + allocation.offset;
+            return allocation;
+        }
+
+        Fox::Vulkan::UploadAllocation UploadRing::AllocateUniform(VkDeviceSize size) {
+            return Allocate(size, uniformAlignment);
+        }
+
+        Fox::Vulkan::UploadAllocation UploadRing::AllocateStorage(VkDeviceSize size) {
+            return Allocate(size, storageAlignment);
+        }
+	}
+}
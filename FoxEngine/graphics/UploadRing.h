@@ -0,0 +1,91 @@
+#pragma once
+
+namespace Fox {
+
+	namespace Vulkan {
+
+		// a sub-range of the upload ring, valid until the same frame index comes around again
+		struct UploadAllocation {
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceSize offset = 0u;
+			VkDeviceSize size = 0u;
+			void* data = nullptr;
+
+			inline bool IsValid() const {
+				return data != nullptr;
+			}
+		};
+
+		struct UploadRingStatistics {
+			uint64_t usedBytes = 0u;		// of the current frame
+			uint64_t peakBytes = 0u;		// largest frame so far
+			uint32_t failedAllocations = 0u;
+		};
+
+		// Persistently mapped, host coherent buffer for data that only lives for one frame, e.g. instance data, dynamic
+		// vertices or debug lines. It is split into one partition per frame in flight and allocates linearly inside the
+		// current one. BeginFrame is called once the frame's fence has signalled, which makes its whole partition free again.
+		// The buffer can be bound as uniform, storage, vertex, index or indirect buffer and as a transfer source.
+		class UploadRing {
+		public:
+			UploadRing(VkDeviceSize partitionSize, uint32_t numFramesInFlight);
+			~UploadRing() = default;
+
+			void BeginFrame(uint32_t frameIndex);
+
+			// returns an invalid allocation when the partition is full
+			Fox::Vulkan::UploadAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
+
+			// aligned for binding the range as a dynamic or plain uniform / storage buffer
+			Fox::Vulkan::UploadAllocation AllocateUniform(VkDeviceSize size);
+			Fox::Vulkan::UploadAllocation AllocateStorage(VkDeviceSize size);
+
+			template<class T>
+			Fox::Vulkan::UploadAllocation Push(const T* data, size_t count, VkDeviceSize alignment = alignof(T)) {
+				Fox::Vulkan::UploadAllocation allocation = Allocate(sizeof(T) * count, alignment);
+				if (allocation.IsValid()) {
+					memcpy(allocation.data, data, sizeof(T) * count);
+				}
+				return allocation;
+			}
+
+			inline VkBuffer GetBuffer() {
+				return buffer->GetBuffer();
+			}
+
+			inline VkDeviceSize GetUniformAlignment() const {
+				return uniformAlignment;
+			}
+
+			inline VkDeviceSize GetStorageAlignment() const {
+				return storageAlignment;
+			}
+
+			inline VkDeviceSize GetPartitionSize() const {
+				return partitionSize;
+			}
+
+			// start of the current frame's partition, aligned for any kind of binding
+			inline VkDeviceSize GetPartitionOffset() const {
+				return static_cast<VkDeviceSize>(frameIndex) * partitionSize;
+			}
+
+			inline const Fox::Vulkan::UploadRingStatistics& GetStatistics() const {
+				return statistics;
+			}
+
+		private:
+			std::unique_ptr<Fox::Vulkan::Buffer<unsigned char>> buffer;
+			uint8_t* mappedMemory = nullptr;
+			VkDeviceSize partitionSize;
+			VkDeviceSize uniformAlignment = 256u;
+			VkDeviceSize storageAlignment = 256u;
+
+			uint32_t frameIndex = 0u;
+			VkDeviceSize head = 0u;			// relative to the current partition
+			bool overflowReported = false;
+
+			Fox::Vulkan::UploadRingStatistics statistics;
+		};
+	}
+}
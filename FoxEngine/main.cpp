@@ -3,8 +3,13 @@
 
 class HelloVideo {
 public:
+    HelloVideo(const std::string& importDirectory = "") : importDirectory(importDirectory) {}
+
     void Run() {
         InitVulkan();
+        if (!importDirectory.empty()) {
+            ImportTextures();
+        }
         MainLoop();
         Cleanup();
     }
@@ -22,6 +27,19 @@ private:
         renderer->Initialize(config);       
     }
 
+    // bulk load benchmark, scaling with the worker count has not been measured yet
+    void ImportTextures() {
+        Fox::Vulkan::TextureManager* textureManager = renderer->GetTextureManager();
+        std::vector<std::string> paths = Fox::Vulkan::TextureImporter::FindImages(importDirectory);
+
+        std::vector<Fox::Vulkan::Texture*> textures = textureManager->Preload(paths);
+        for (size_t i = 0; i < paths.size(); i++) {
+            if (textures[i]) {
+                textureManager->Release(paths[i]);
+            }
+        }
+    }
+
 
 
 
@@ -59,12 +77,28 @@ private:
 protected:
     std::unique_ptr<Fox::Vulkan::Renderer> renderer;
     SDL_Window* window;
+    std::string importDirectory;
 
 
 };
 
 int main(int argc, char** args) {
-    HelloVideo app;
+    std::string importDirectory;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::string(args[i]) == "--benchmark") {
+            Fox::Core::ThreadPool threadPool;
+            Fox::Core::BlockCompression::Benchmark(2048, 2048);
+            Fox::Core::BlockCompression::Benchmark(2048, 2048, &threadPool);
+            Fox::Core::RadixSort::Benchmark(100000u);
+            return EXIT_SUCCESS;
+        }
+        if (std::string(args[i]) == "--import" && i + 1 < argc) {
+            importDirectory = args[++i];
+        }
+    }
+
+    HelloVideo app(importDirectory);
 
     try {
         app.Run();
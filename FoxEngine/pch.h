@@ -16,6 +16,7 @@
 #include <unordered_map>
 #include <random>
 #include <functional>
+#include <deque>
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_Vulkan.h>
@@ -41,20 +42,42 @@ namespace Fox {
 			alignas(16) glm::mat4 proj;
 		};
 
+		// shared by every instance of a model, the transforms are per instance
 		struct PerObjectConstantBuffer {
+			alignas(16) glm::vec4 texCoordTransform;	// scale in xy, offset in zw
+			uint32_t textureLayer;
+			uint32_t textureIndex;	// bindless texture table slot
+		};
+
+		struct PerInstanceData {
 			alignas(16) glm::mat4 model;
+			uint32_t drawIndex;		// per-draw data of indirect pipelines
 		};
 	}
 }
 
 #include "core/JSON.h"
+#include "core/TlsfAllocator.h"
+#include "core/ThreadPool.h"
+#include "core/BlockCompression.h"
+#include "core/MipGenerator.h"
+#include "core/MappedFile.h"
+#include "core/TextureContainer.h"
+#include "core/SkylinePacker.h"
+#include "core/RadixSort.h"
 
 #include "graphics/Vertex.h"
+#include "graphics/Bounds.h"
 #include "graphics/RendererConfig.h"
+#include "graphics/MemoryAllocator.h"
 #include "graphics/Buffer.h"
+#include "graphics/StagingPool.h"
+#include "graphics/GeometryPool.h"
 #include "graphics/Mesh.h"
 #include "graphics/Texture.h"
+#include "graphics/TextureAtlas.h"
 #include "graphics/Model.h"
+#include "graphics/MeshCache.h"
 #include "graphics/SceneNode.h"
 #include "graphics/ModelNode.h"
 #include "graphics/SceneGraph.h"
@@ -62,11 +85,15 @@ namespace Fox {
 #include "core/FileSystem.h"
 #include "graphics/Synchronization.h"
 #include "graphics/ConstantBuffers.h"
+#include "graphics/UploadRing.h"
 #include "graphics/TextureManager.h"
+#include "graphics/TextureImporter.h"
+#include "graphics/StreamingManager.h"
 #include "graphics/SamplerManager.h"
 #include "graphics/DescriptorSetManager.h"
 #include "graphics/RenderPassManager.h"
 #include "graphics/PipelineConfig.h"
 #include "graphics/GraphicsPipelineState.h"
+#include "graphics/RenderQueue.h"
 #include "graphics/Renderer.h"
 
@@ -0,0 +1,39 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform PerFrame {
+    mat4 model;
+    mat4 view; 
+    mat4 proj;
+} ubo;
+
+layout(push_constant) uniform PerObject {
+    vec4 texCoordTransform;
+    uint textureLayer;
+    uint textureIndex;
+} ubo2;
+
+struct Instance {
+    mat4 model;
+    uint drawIndex;
+};
+
+layout(set = 0, binding = 3) readonly buffer Instances {
+    Instance data[];
+} instances;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureLayer;
+layout(location = 3) flat out uint fragTextureIndex;
+
+void main() {
+    gl_Position = ubo.proj * ubo.view * instances.data[gl_InstanceIndex].model * vec4(inPosition, 1.0);
+    fragColor = inColor;
+    fragTexCoord = inTexCoord * ubo2.texCoordTransform.xy + ubo2.texCoordTransform.zw;
+    fragTextureLayer = ubo2.textureLayer;
+    fragTextureIndex = ubo2.textureIndex;
+}
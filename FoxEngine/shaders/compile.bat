@@ -0,0 +1,6 @@
+C:\VulkanSDK/1.3.275.0/Bin/glslc.exe shader.vert -o vert.spv
+C:\VulkanSDK/1.3.275.0/Bin/glslc.exe shader.frag -o frag.spv
+C:\VulkanSDK/1.3.275.0/Bin/glslc.exe bindless.vert -o bindless_vert.spv
+C:\VulkanSDK/1.3.275.0/Bin/glslc.exe bindless.frag -o bindless_frag.spv
+C:\VulkanSDK/1.3.275.0/Bin/glslc.exe indirect.vert -o indirect_vert.spv
+pause
\ No newline at end of file
@@ -0,0 +1,46 @@
+#version 450
+
+layout(set = 0, binding = 0) uniform PerFrame {
+    mat4 model;
+    mat4 view; 
+    mat4 proj;
+} ubo;
+
+struct Instance {
+    mat4 model;
+    uint drawIndex;
+};
+
+layout(set = 0, binding = 3) readonly buffer Instances {
+    Instance data[];
+} instances;
+
+struct PerObject {
+    vec4 texCoordTransform;
+    uint textureLayer;
+    uint textureIndex;
+};
+
+layout(set = 0, binding = 4) readonly buffer Draws {
+    PerObject data[];
+} draws;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureLayer;
+layout(location = 3) flat out uint fragTextureIndex;
+
+void main() {
+    Instance instance = instances.data[gl_InstanceIndex];
+    PerObject object = draws.data[instance.drawIndex];
+
+    gl_Position = ubo.proj * ubo.view * instance.model * vec4(inPosition, 1.0);
+    fragColor = inColor;
+    fragTexCoord = inTexCoord * object.texCoordTransform.xy + object.texCoordTransform.zw;
+    fragTextureLayer = object.textureLayer;
+    fragTextureIndex = object.textureIndex;
+}
@@ -2,11 +2,12 @@
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragTextureLayer;
 
-layout(binding = 2) uniform sampler2D texSampler;
+layout(binding = 2) uniform sampler2DArray texSampler;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-	outColor =  texture(texSampler, fragTexCoord);
+	outColor =  texture(texSampler, vec3(fragTexCoord, fragTextureLayer));
 }
\ No newline at end of file
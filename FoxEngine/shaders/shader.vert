@@ -7,18 +7,30 @@ layout(binding = 0) uniform PerFrame {
 } ubo;
 
 layout(binding = 1) uniform PerObject {
-    mat4 model;
+    vec4 texCoordTransform;
+    uint textureLayer;
 } ubo2;
 
+struct Instance {
+    mat4 model;
+    uint drawIndex;
+};
+
+layout(binding = 3) readonly buffer Instances {
+    Instance data[];
+} instances;
+
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
 layout(location = 2) in vec2 inTexCoord;
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureLayer;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo2.model * vec4(inPosition, 1.0);
+    gl_Position = ubo.proj * ubo.view * instances.data[gl_InstanceIndex].model * vec4(inPosition, 1.0);
     fragColor = inColor;
-    fragTexCoord = inTexCoord;
+    fragTexCoord = inTexCoord * ubo2.texCoordTransform.xy + ubo2.texCoordTransform.zw;
+    fragTextureLayer = ubo2.textureLayer;
 } 
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Tests {
+
+        // Reference decoders written from the format specifications, independent of the encoder. Output is RGBA8 per 4x4 block.
+
+        static void DecodeRGB565(uint16_t value, int32_t* color) {
+            int32_t r = (value >> 11) & 31;
+            int32_t g = (value >> 5) & 63;
+            int32_t b = value & 31;
+            color[0] = (r << 3) | (r >> 2);
+            color[1] = (g << 2) | (g >> 4);
+            color[2] = (b << 3) | (b >> 2);
+        }
+
+        static void DecodeBC1(const uint8_t* input, uint8_t* pixels) {
+            uint16_t color0 = static_cast<uint16_t>(input[0] | (input[1] << 8));
+            uint16_t color1 = static_cast<uint16_t>(input[2] | (input[3] << 8));
+            uint32_t indices = input[4] | (input[5] << 8) | (input[6] << 16) | (static_cast<uint32_t>(input[7]) << 24);
+
+            int32_t palette[4][3];
+            DecodeRGB565(color0, palette[0]);
+            DecodeRGB565(color1, palette[1]);
+            for (uint32_t c = 0u; c < 3u; c++) {
+                if (color0 > color1) {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                } else {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+
+            for (uint32_t i = 0u; i < 16u; i++) {
+                uint32_t index = (indices >> (i * 2u)) & 3u;
+                for (uint32_t c = 0u; c < 3u; c++) {
+                    pixels[i * 4u + c] = static_cast<uint8_t>(palette[index][c]);
+                }
+                pixels[i * 4u + 3u] = 255u;
+            }
+        }
+
+        static void DecodeBC4(const uint8_t* input, uint32_t channel, uint8_t* pixels) {
+            int32_t palette[8];
+            palette[0] = input[0];
+            palette[1] = input[1];
+            if (palette[0] > palette[1]) {
+                for (int32_t p = 2; p < 8; p++) {
+                    palette[p] = ((8 - p) * palette[0] + (p - 1) * palette[1]) / 7;
+                }
+            } else {
+                for (int32_t p = 2; p < 6; p++) {
+                    palette[p] = ((6 - p) * palette[0] + (p - 1) * palette[1]) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+
+            uint64_t indices = 0u;
+            for (uint32_t b = 0u; b < 6u; b++) {
+                indices |= static_cast<uint64_t>(input[2 + b]) << (b * 8u);
+            }
+
+            for (uint32_t i = 0u; i < 16u; i++) {
+                pixels[i * 4u + channel] = static_cast<uint8_t>(palette[(indices >> (i * 3u)) & 7u]);
+            }
+        }
+
+        static void DecodeBC3(const uint8_t* input, uint8_t* pixels) {
+            DecodeBC1(input + 8, pixels);
+            DecodeBC4(input, 3u, pixels);
+        }
+
+        static void DecodeBC5(const uint8_t* input, uint8_t* pixels) {
+            for (uint32_t i = 0u; i < 16u; i++) {
+                pixels[i * 4u + 2u] = 0u;
+                pixels[i * 4u + 3u] = 255u;
+            }
+            DecodeBC4(input, 0u, pixels);
+            DecodeBC4(input + 8, 1u, pixels);
+        }
+
+        // mode 6 only, any other mode decodes to an obviously wrong magenta
+        static void DecodeBC7(const uint8_t* input, uint8_t* pixels) {
+            static const int32_t weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+            uint32_t position = 0u;
+            auto read = [&](uint32_t bits) {
+                uint32_t value = 0u;
+                for (uint32_t b = 0u; b < bits; b++, position++) {
+                    value |= ((input[position >> 3u] >> (position & 7u)) & 1u) << b;
+                }
+                return value;
+            };
+
+            if (read(7u) != (1u << 6u)) {
+                for (uint32_t i = 0u; i < 16u; i++) {
+                    pixels[i * 4u + 0u] = 255u;
+                    pixels[i * 4u + 1u] = 0u;
+                    pixels[i * 4u + 2u] = 255u;
+                    pixels[i * 4u + 3u] = 255u;
+                }
+                return;
+            }
+
+            uint32_t endpoints[2][4];
+            for (uint32_t c = 0u; c < 4u; c++) {
+                endpoints[0][c] = read(7u);
+                endpoints[1][c] = read(7u);
+            }
+            uint32_t pBits[2] = { read(1u), read(1u) };
+            for (uint32_t e = 0u; e < 2u; e++) {
+                for (uint32_t c = 0u; c < 4u; c++) {
+                    endpoints[e][c] = (endpoints[e][c] << 1u) | pBits[e];
+                }
+            }
+
+            for (uint32_t i = 0u; i < 16u; i++) {
+                uint32_t index = read(i == 0u ? 3u : 4u);
+                for (uint32_t c = 0u; c < 4u; c++) {
+                    pixels[i * 4u + c] = static_cast<uint8_t>(((64 - weights[index]) * endpoints[0][c] + weights[index] * endpoints[1][c] + 32) >> 6);
+                }
+            }
+        }
+
+        static std::vector<uint8_t> Decode(Fox::Core::BlockFormat format, const std::vector<uint8_t>& blocks, uint32_t width, uint32_t height) {
+            std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4u);
+            uint32_t blocksX = (width + 3u) / 4u;
+            uint32_t blockSize = Fox::Core::BlockCompression::GetBlockSize(format);
+
+            for (uint32_t blockY = 0u; blockY * 4u < height; blockY++) {
+                for (uint32_t blockX = 0u; blockX < blocksX; blockX++) {
+                    const uint8_t* input = &blocks[(static_cast<size_t>(blockY) * blocksX + blockX) * blockSize];
+                    uint8_t pixels[64];
+                    switch (format) {
+                    case Fox::Core::BlockFormat::BC1:
+                        DecodeBC1(input, pixels);
+                        break;
+                    case Fox::Core::BlockFormat::BC3:
+                        DecodeBC3(input, pixels);
+                        break;
+                    case Fox::Core::BlockFormat::BC5:
+                        DecodeBC5(input, pixels);
+                        break;
+                    case Fox::Core::BlockFormat::BC7:
+                        DecodeBC7(input, pixels);
+                        break;
+                    }
+
+                    for (uint32_t y = 0u; y < 4u && blockY * 4u + y < height; y++) {
+                        for (uint32_t x = 0u; x < 4u && blockX * 4u + x < width; x++) {
+                            memcpy(&rgba[((static_cast<size_t>(blockY) * 4u + y) * width + blockX * 4u + x) * 4u], &pixels[(y * 4u + x) * 4u], 4u);
+                        }
+                    }
+                }
+            }
+
+            return rgba;
+        }
+
+        // the channels a format stores: BC1 has no alpha, BC5 only red and green
+        static uint32_t GetChannelMask(Fox::Core::BlockFormat format) {
+            switch (format) {
+            case Fox::Core::BlockFormat::BC1:
+                return 0x7u;
+            case Fox::Core::BlockFormat::BC5:
+                return 0x3u;
+            default:
+                return 0xFu;
+            }
+        }
+
+        static double RootMeanSquareError(Fox::Core::BlockFormat format, const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+            uint32_t mask = GetChannelMask(format);
+            double sum = 0.0;
+            size_t count = 0u;
+            for (size_t i = 0u; i < a.size(); i++) {
+                if (mask & (1u << (i % 4u))) {
+                    double difference = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+                    sum += difference * difference;
+                    count++;
+                }
+            }
+            return std::sqrt(sum / static_cast<double>(count));
+        }
+
+        static int32_t MaxError(Fox::Core::BlockFormat format, const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+            uint32_t mask = GetChannelMask(format);
+            int32_t error = 0;
+            for (size_t i = 0u; i < a.size(); i++) {
+                if (mask & (1u << (i % 4u))) {
+                    error = std::max(error, std::abs(static_cast<int32_t>(a[i]) - static_cast<int32_t>(b[i])));
+                }
+            }
+            return error;
+        }
+
+        static std::vector<uint8_t> MakeGradient(uint32_t width, uint32_t height) {
+            std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4u);
+            for (uint32_t y = 0u; y < height; y++) {
+                for (uint32_t x = 0u; x < width; x++) {
+                    uint8_t* pixel = &rgba[(static_cast<size_t>(y) * width + x) * 4u];
+                    pixel[0] = static_cast<uint8_t>(x * 255u / std::max(width - 1u, 1u));
+                    pixel[1] = static_cast<uint8_t>(y * 255u / std::max(height - 1u, 1u));
+                    pixel[2] = static_cast<uint8_t>(128.0 + 100.0 * std::sin(0.2 * x + 0.1 * y));
+                    pixel[3] = static_cast<uint8_t>(255u - (x + y) * 255u / std::max(width + height - 2u, 1u));
+                }
+            }
+            return rgba;
+        }
+
+        static const Fox::Core::BlockFormat FORMATS[] = { Fox::Core::BlockFormat::BC1, Fox::Core::BlockFormat::BC3, Fox::Core::BlockFormat::BC5,
+            Fox::Core::BlockFormat::BC7 };
+
+        static void TestSizes() {
+            FOX_CHECK(Fox::Core::BlockCompression::GetBlockSize(Fox::Core::BlockFormat::BC1) == 8u);
+            FOX_CHECK(Fox::Core::BlockCompression::GetBlockSize(Fox::Core::BlockFormat::BC7) == 16u);
+            FOX_CHECK(Fox::Core::BlockCompression::GetCompressedSize(Fox::Core::BlockFormat::BC1, 1u, 1u) == 8u);
+            FOX_CHECK(Fox::Core::BlockCompression::GetCompressedSize(Fox::Core::BlockFormat::BC1, 5u, 3u) == 16u);
+            FOX_CHECK(Fox::Core::BlockCompression::GetCompressedSize(Fox::Core::BlockFormat::BC3, 8u, 8u) == 64u);
+            FOX_CHECK(Fox::Core::BlockCompression::GetCompressedSize(Fox::Core::BlockFormat::BC7, 9u, 4u) == 48u);
+        }
+
+        static void TestSolidColour() {
+            std::vector<uint8_t> rgba(4u * 4u * 4u);
+            for (size_t i = 0u; i < rgba.size(); i += 4u) {
+                rgba[i + 0u] = 200u;
+                rgba[i + 1u] = 90u;
+                rgba[i + 2u] = 17u;
+                rgba[i + 3u] = 140u;
+            }
+
+            // 5/6/5 bits leave up to half a step of error, the 8-bit BC4 endpoints are exact and BC7 loses at most the p-bit
+            const int32_t tolerance[] = { 4, 4, 0, 1 };
+            for (size_t f = 0u; f < std::size(FORMATS); f++) {
+                std::vector<uint8_t> blocks = Fox::Core::BlockCompression::Compress(FORMATS[f], rgba.data(), 4u, 4u);
+                FOX_CHECK(MaxError(FORMATS[f], rgba, Decode(FORMATS[f], blocks, 4u, 4u)) <= tolerance[f]);
+            }
+
+            std::vector<uint8_t> bc3 = Fox::Core::BlockCompression::Compress(Fox::Core::BlockFormat::BC3, rgba.data(), 4u, 4u);
+            FOX_CHECK(Decode(Fox::Core::BlockFormat::BC3, bc3, 4u, 4u)[3] == 140u);
+        }
+
+        static void TestGradient() {
+            const uint32_t width = 64u;
+            const uint32_t height = 48u;
+            std::vector<uint8_t> rgba = MakeGradient(width, height);
+
+            // generous bounds, a broken index or endpoint order shows up as an error of tens
+            const double tolerance[] = { 6.0, 6.0, 3.0, 4.0 };
+            for (size_t f = 0u; f < std::size(FORMATS); f++) {
+                std::vector<uint8_t> blocks = Fox::Core::BlockCompression::Compress(FORMATS[f], rgba.data(), width, height);
+                FOX_CHECK(blocks.size() == Fox::Core::BlockCompression::GetCompressedSize(FORMATS[f], width, height));
+                FOX_CHECK(RootMeanSquareError(FORMATS[f], rgba, Decode(FORMATS[f], blocks, width, height)) < tolerance[f]);
+            }
+        }
+
+        static void TestPartialBlocks() {
+            // two flat halves in an image whose edge blocks are only partly covered
+            const uint32_t width = 6u;
+            const uint32_t height = 7u;
+            std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4u);
+            for (uint32_t y = 0u; y < height; y++) {
+                for (uint32_t x = 0u; x < width; x++) {
+                    uint8_t value = x < 4u ? 30u : 220u;
+                    uint8_t* pixel = &rgba[(static_cast<size_t>(y) * width + x) * 4u];
+                    pixel[0] = pixel[1] = pixel[2] = pixel[3] = value;
+                }
+            }
+
+            for (Fox::Core::BlockFormat format : FORMATS) {
+                std::vector<uint8_t> blocks = Fox::Core::BlockCompression::Compress(format, rgba.data(), width, height);
+                FOX_CHECK(MaxError(format, rgba, Decode(format, blocks, width, height)) <= 4);
+            }
+        }
+
+        static void TestThreadPool() {
+            const uint32_t width = 64u;
+            const uint32_t height = 40u;
+            std::vector<uint8_t> rgba = MakeGradient(width, height);
+            Fox::Core::ThreadPool threadPool(2u);
+
+            for (Fox::Core::BlockFormat format : FORMATS) {
+                std::vector<uint8_t> serial = Fox::Core::BlockCompression::Compress(format, rgba.data(), width, height);
+                std::vector<uint8_t> parallel = Fox::Core::BlockCompression::Compress(format, rgba.data(), width, height, &threadPool);
+                FOX_CHECK(serial == parallel);
+            }
+        }
+
+        void RunBlockCompressionTests() {
+            TestSizes();
+            TestSolidColour();
+            TestGradient();
+            TestPartialBlocks();
+            TestThreadPool();
+        }
+	}
+}
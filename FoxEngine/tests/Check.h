@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+
+namespace Fox {
+
+	namespace Tests {
+
+		// a failed check is printed and counted, the run goes on so one pass reports every failure
+		struct CheckResults {
+			uint32_t passed = 0u;
+			uint32_t failed = 0u;
+		};
+
+		inline Fox::Tests::CheckResults& GetResults() {
+			static Fox::Tests::CheckResults results;
+			return results;
+		}
+
+		inline bool Check(bool condition, const char* expression, const char* file, int line) {
+			if (condition) {
+				GetResults().passed++;
+			} else {
+				GetResults().failed++;
+				std::cout << file << "(" << line << "): check failed: " << expression << std::endl;
+			}
+			return condition;
+		}
+
+		void RunTlsfAllocatorTests();
+		void RunBlockCompressionTests();
+		void RunMipGeneratorTests();
+		void RunTextureContainerTests();
+		void RunSkylinePackerTests();
+		void RunRadixSortTests();
+	}
+}
+
+#define FOX_CHECK(condition) Fox::Tests::Check((condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,161 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Tests {
+
+        static const Fox::Core::MipFilter FILTERS[] = { Fox::Core::MipFilter::Box, Fox::Core::MipFilter::Kaiser, Fox::Core::MipFilter::Lanczos };
+
+        static std::vector<uint8_t> MakeImage(uint32_t width, uint32_t height, std::function<void(uint32_t, uint32_t, uint8_t*)> pixel) {
+            std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4u);
+            for (uint32_t y = 0u; y < height; y++) {
+                for (uint32_t x = 0u; x < width; x++) {
+                    pixel(x, y, &rgba[(static_cast<size_t>(y) * width + x) * 4u]);
+                }
+            }
+            return rgba;
+        }
+
+        static double Mean(const std::vector<uint8_t>& pixels, uint32_t channel) {
+            double sum = 0.0;
+            for (size_t i = channel; i < pixels.size(); i += 4u) {
+                sum += pixels[i];
+            }
+            return sum / static_cast<double>(pixels.size() / 4u);
+        }
+
+        static void TestLevelCount() {
+            FOX_CHECK(Fox::Core::MipGenerator::GetLevelCount(1u, 1u) == 1u);
+            FOX_CHECK(Fox::Core::MipGenerator::GetLevelCount(256u, 256u) == 9u);
+            FOX_CHECK(Fox::Core::MipGenerator::GetLevelCount(300u, 17u) == 9u);
+            FOX_CHECK(Fox::Core::MipGenerator::GetLevelCount(1u, 64u) == 7u);
+        }
+
+        static void TestChainSizes() {
+            std::vector<uint8_t> rgba = MakeImage(37u, 10u, [](uint32_t x, uint32_t y, uint8_t* pixel) {
+                pixel[0] = static_cast<uint8_t>(x * 7u);
+                pixel[1] = static_cast<uint8_t>(y * 25u);
+                pixel[2] = 0u;
+                pixel[3] = 255u;
+            });
+
+            std::vector<Fox::Core::MipImage> chain = Fox::Core::MipGenerator::Generate(rgba.data(), 37u, 10u, Fox::Core::MipFilter::Kaiser, false);
+            const uint32_t widths[] = { 37u, 18u, 9u, 4u, 2u, 1u };
+            const uint32_t heights[] = { 10u, 5u, 2u, 1u, 1u, 1u };
+
+            FOX_CHECK(chain.size() == std::size(widths));
+            for (size_t level = 0u; level < std::min(chain.size(), std::size(widths)); level++) {
+                FOX_CHECK(chain[level].width == widths[level] && chain[level].height == heights[level]);
+                FOX_CHECK(chain[level].pixels.size() == static_cast<size_t>(widths[level]) * heights[level] * 4u);
+            }
+            FOX_CHECK(chain[0].pixels == rgba);
+        }
+
+        static void TestConstantImage() {
+            // the filter weights sum to one and the sRGB tables round trip, so a flat image stays flat at every level
+            for (Fox::Core::MipFilter filter : FILTERS) {
+                for (bool srgb : { false, true }) {
+                    for (uint8_t value : { 0, 1, 77, 128, 200, 254, 255 }) {
+                        std::vector<uint8_t> rgba = MakeImage(16u, 8u, [value](uint32_t, uint32_t, uint8_t* pixel) {
+                            pixel[0] = pixel[1] = pixel[2] = pixel[3] = value;
+                        });
+
+                        bool flat = true;
+                        for (const Fox::Core::MipImage& image : Fox::Core::MipGenerator::Generate(rgba.data(), 16u, 8u, filter, srgb)) {
+                            flat = flat && std::all_of(image.pixels.begin(), image.pixels.end(), [value](uint8_t p) { return p == value; });
+                        }
+                        FOX_CHECK(flat);
+                    }
+                }
+            }
+        }
+
+        static void TestLinearSpaceAverage() {
+            // black and white average to half the light, which sRGB stores as 188 and not 128; alpha is always linear
+            std::vector<uint8_t> rgba = MakeImage(2u, 1u, [](uint32_t x, uint32_t, uint8_t* pixel) {
+                pixel[0] = pixel[1] = pixel[2] = pixel[3] = x == 0u ? 0u : 255u;
+            });
+
+            std::vector<Fox::Core::MipImage> srgbChain = Fox::Core::MipGenerator::Generate(rgba.data(), 2u, 1u, Fox::Core::MipFilter::Box, true);
+            FOX_CHECK(srgbChain.size() == 2u);
+            FOX_CHECK(std::abs(srgbChain[1].pixels[0] - 188) <= 1);
+            FOX_CHECK(std::abs(srgbChain[1].pixels[3] - 128) <= 1);
+
+            std::vector<Fox::Core::MipImage> linearChain = Fox::Core::MipGenerator::Generate(rgba.data(), 2u, 1u, Fox::Core::MipFilter::Box, false);
+            FOX_CHECK(std::abs(linearChain[1].pixels[0] - 128) <= 1);
+        }
+
+        static void TestBoxAverage() {
+            std::mt19937 random(7u);
+            std::vector<uint8_t> rgba = MakeImage(8u, 8u, [&random](uint32_t, uint32_t, uint8_t* pixel) {
+                for (uint32_t c = 0u; c < 4u; c++) {
+                    pixel[c] = static_cast<uint8_t>(random());
+                }
+            });
+
+            std::vector<Fox::Core::MipImage> chain = Fox::Core::MipGenerator::Generate(rgba.data(), 8u, 8u, Fox::Core::MipFilter::Box, false);
+            bool averaged = true;
+            for (uint32_t y = 0u; y < 4u; y++) {
+                for (uint32_t x = 0u; x < 4u; x++) {
+                    for (uint32_t c = 0u; c < 4u; c++) {
+                        int32_t sum = 0;
+                        for (uint32_t i = 0u; i < 4u; i++) {
+                            sum += rgba[((y * 2u + i / 2u) * 8u + x * 2u + i % 2u) * 4u + c];
+                        }
+                        averaged = averaged && std::abs(chain[1].pixels[(y * 4u + x) * 4u + c] * 4 - sum) <= 4;
+                    }
+                }
+            }
+            FOX_CHECK(averaged);
+        }
+
+        static void TestMeanPreserved() {
+            std::vector<uint8_t> rgba = MakeImage(64u, 48u, [](uint32_t x, uint32_t y, uint8_t* pixel) {
+                pixel[0] = static_cast<uint8_t>(x * 4u);
+                pixel[1] = static_cast<uint8_t>(y * 5u);
+                pixel[2] = static_cast<uint8_t>(128.0 + 90.0 * std::sin(0.3 * x) * std::cos(0.2 * y));
+                pixel[3] = 255u;
+            });
+
+            for (Fox::Core::MipFilter filter : FILTERS) {
+                std::vector<Fox::Core::MipImage> chain = Fox::Core::MipGenerator::Generate(rgba.data(), 64u, 48u, filter, false);
+                bool preserved = true;
+                for (uint32_t c = 0u; c < 3u; c++) {
+                    preserved = preserved && std::abs(Mean(chain[1].pixels, c) - Mean(rgba, c)) < 2.0;
+                }
+                FOX_CHECK(preserved);
+            }
+        }
+
+        static void TestThreadPool() {
+            std::vector<uint8_t> rgba = MakeImage(64u, 40u, [](uint32_t x, uint32_t y, uint8_t* pixel) {
+                pixel[0] = static_cast<uint8_t>(x * y);
+                pixel[1] = static_cast<uint8_t>(x ^ y);
+                pixel[2] = static_cast<uint8_t>(x * 3u);
+                pixel[3] = static_cast<uint8_t>(y * 6u);
+            });
+            Fox::Core::ThreadPool threadPool(2u);
+
+            for (Fox::Core::MipFilter filter : FILTERS) {
+                std::vector<Fox::Core::MipImage> serial = Fox::Core::MipGenerator::Generate(rgba.data(), 64u, 40u, filter, true);
+                std::vector<Fox::Core::MipImage> parallel = Fox::Core::MipGenerator::Generate(rgba.data(), 64u, 40u, filter, true, &threadPool);
+
+                bool equal = serial.size() == parallel.size();
+                for (size_t level = 0u; equal && level < serial.size(); level++) {
+                    equal = serial[level].pixels == parallel[level].pixels;
+                }
+                FOX_CHECK(equal);
+            }
+        }
+
+        void RunMipGeneratorTests() {
+            TestLevelCount();
+            TestChainSizes();
+            TestConstantImage();
+            TestLinearSpaceAverage();
+            TestBoxAverage();
+            TestMeanPreserved();
+            TestThreadPool();
+        }
+	}
+}
@@ -0,0 +1,80 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Tests {
+
+        // the reference is std::stable_sort, radix sort has to agree with it on the order of equal keys too
+        static bool SortsLikeStableSort(std::vector<Fox::Core::SortItem> items) {
+            std::vector<Fox::Core::SortItem> expected = items;
+            std::stable_sort(expected.begin(), expected.end(), [](const Fox::Core::SortItem& a, const Fox::Core::SortItem& b) {
+                return a.key < b.key;
+            });
+
+            std::vector<Fox::Core::SortItem> scratch(items.size());
+            Fox::Core::RadixSort::Sort(items.data(), scratch.data(), items.size());
+
+            for (size_t i = 0u; i < items.size(); i++) {
+                if (items[i].key != expected[i].key || items[i].value != expected[i].value) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static void TestSmall() {
+            FOX_CHECK(SortsLikeStableSort({}));
+            FOX_CHECK(SortsLikeStableSort({ { 5u, 0u } }));
+            FOX_CHECK(SortsLikeStableSort({ { 5u, 0u }, { 3u, 1u } }));
+            FOX_CHECK(SortsLikeStableSort({ { ~0ull, 0u }, { 0u, 1u }, { 1ull << 63u, 2u }, { 0u, 3u } }));
+        }
+
+        static void TestRandomKeys() {
+            std::mt19937_64 random(11u);
+            std::vector<Fox::Core::SortItem> items(10000u);
+            for (uint32_t i = 0u; i < items.size(); i++) {
+                items[i] = { random(), i };
+            }
+            FOX_CHECK(SortsLikeStableSort(items));
+        }
+
+        static void TestStability() {
+            // few distinct keys, so most items share theirs with many others
+            std::mt19937_64 random(12u);
+            std::vector<Fox::Core::SortItem> items(5000u);
+            for (uint32_t i = 0u; i < items.size(); i++) {
+                items[i] = { random() % 7u, i };
+            }
+            FOX_CHECK(SortsLikeStableSort(items));
+        }
+
+        static void TestSkippedPasses() {
+            // draw keys only use a few of their bytes, the passes over the constant ones are skipped
+            std::mt19937_64 random(13u);
+            std::vector<Fox::Core::SortItem> items(3000u);
+            for (uint32_t i = 0u; i < items.size(); i++) {
+                items[i] = { 0xAB00000000000000ull | ((random() & 0xFFu) << 40u) | (random() & 0xFFFFu), i };
+            }
+            FOX_CHECK(SortsLikeStableSort(items));
+
+            // an odd number of passes leaves the result in the scratch array, it has to be copied back
+            for (uint32_t i = 0u; i < items.size(); i++) {
+                items[i] = { random() & 0xFFu, i };
+            }
+            FOX_CHECK(SortsLikeStableSort(items));
+
+            std::vector<Fox::Core::SortItem> equal(100u, { 42u, 0u });
+            for (uint32_t i = 0u; i < equal.size(); i++) {
+                equal[i].value = i;
+            }
+            FOX_CHECK(SortsLikeStableSort(equal));
+        }
+
+        void RunRadixSortTests() {
+            TestSmall();
+            TestRandomKeys();
+            TestStability();
+            TestSkippedPasses();
+        }
+	}
+}
@@ -0,0 +1,100 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Tests {
+
+        struct PackedRect {
+            uint32_t x;
+            uint32_t y;
+            uint32_t width;
+            uint32_t height;
+        };
+
+        static bool Overlap(const PackedRect& a, const PackedRect& b) {
+            return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+        }
+
+        static void TestExactFit() {
+            // four quarters fill the page completely, a fifth rectangle of any size has no room
+            Fox::Core::SkylinePacker packer(64u, 64u);
+            std::vector<PackedRect> rects;
+            for (uint32_t i = 0u; i < 4u; i++) {
+                PackedRect rect{ 0u, 0u, 32u, 32u };
+                FOX_CHECK(packer.Insert(rect.width, rect.height, rect.x, rect.y));
+                rects.push_back(rect);
+            }
+
+            bool disjoint = true;
+            for (size_t i = 0u; i < rects.size(); i++) {
+                for (size_t j = i + 1u; j < rects.size(); j++) {
+                    disjoint = disjoint && !Overlap(rects[i], rects[j]);
+                }
+            }
+            FOX_CHECK(disjoint);
+            FOX_CHECK(packer.GetOccupancy() == 1.0f);
+
+            uint32_t x, y;
+            FOX_CHECK(!packer.Insert(1u, 1u, x, y));
+        }
+
+        static void TestTooLarge() {
+            Fox::Core::SkylinePacker packer(32u, 16u);
+            uint32_t x, y;
+            FOX_CHECK(!packer.Insert(33u, 1u, x, y));
+            FOX_CHECK(!packer.Insert(1u, 17u, x, y));
+            FOX_CHECK(packer.Insert(32u, 16u, x, y));
+            FOX_CHECK(x == 0u && y == 0u);
+        }
+
+        static void TestBottomLeft() {
+            // the second rectangle goes next to the first on the floor rather than on top of it
+            Fox::Core::SkylinePacker packer(100u, 100u);
+            uint32_t x, y;
+            FOX_CHECK(packer.Insert(30u, 50u, x, y) && x == 0u && y == 0u);
+            FOX_CHECK(packer.Insert(30u, 10u, x, y) && x == 30u && y == 0u);
+            FOX_CHECK(packer.Insert(40u, 20u, x, y) && x == 60u && y == 0u);
+            // the lowest spot is now on the 10 high rectangle
+            FOX_CHECK(packer.Insert(30u, 5u, x, y) && x == 30u && y == 10u);
+        }
+
+        static void TestRandom() {
+            const uint32_t size = 512u;
+            Fox::Core::SkylinePacker packer(size, size);
+            std::mt19937 random(3u);
+            std::vector<PackedRect> rects;
+            uint64_t area = 0u;
+
+            for (uint32_t i = 0u; i < 2000u; i++) {
+                uint32_t width = 4u + static_cast<uint32_t>(random() % 60u);
+                uint32_t height = 4u + static_cast<uint32_t>(random() % 60u);
+                PackedRect rect{ 0u, 0u, width, height };
+                if (packer.Insert(rect.width, rect.height, rect.x, rect.y)) {
+                    rects.push_back(rect);
+                    area += static_cast<uint64_t>(rect.width) * rect.height;
+                }
+            }
+
+            bool inside = true;
+            bool disjoint = true;
+            for (size_t i = 0u; i < rects.size(); i++) {
+                inside = inside && rects[i].x + rects[i].width <= size && rects[i].y + rects[i].height <= size;
+                for (size_t j = i + 1u; j < rects.size(); j++) {
+                    disjoint = disjoint && !Overlap(rects[i], rects[j]);
+                }
+            }
+            FOX_CHECK(inside);
+            FOX_CHECK(disjoint);
+            FOX_CHECK(std::abs(packer.GetOccupancy() - static_cast<float>(area) / static_cast<float>(size * size)) < 1.0e-6f);
+            // random sizes up to an eighth of the page still fill most of it
+            FOX_CHECK(packer.GetOccupancy() > 0.7f);
+        }
+
+        void RunSkylinePackerTests() {
+            TestExactFit();
+            TestTooLarge();
+            TestBottomLeft();
+            TestRandom();
+        }
+	}
+}
@@ -0,0 +1,149 @@
+#include "pch.h"
+
+#include <filesystem>
+
+namespace Fox {
+
+	namespace Tests {
+
+        static std::string GetTemporaryPath(const std::string& name) {
+            std::filesystem::path directory = std::filesystem::temp_directory_path() / "FoxEngineTests";
+            std::filesystem::create_directories(directory);
+            return (directory / name).string();
+        }
+
+        static Fox::Core::TextureContainer MakeContainer() {
+            Fox::Core::TextureContainer container;
+            container.format = 146u;
+            container.width = 8u;
+            container.height = 4u;
+            container.layerCount = 2u;
+            container.mipFilter = 2u;
+
+            uint64_t offset = 0u;
+            for (uint32_t width = 8u, height = 4u; ; width = std::max(width / 2u, 1u), height = std::max(height / 2u, 1u)) {
+                Fox::Core::TextureLevel level;
+                level.width = width;
+                level.height = height;
+                level.offset = Fox::Core::TextureContainer::AlignLevelOffset(offset);
+                level.size = static_cast<uint64_t>(width) * height * 4u * container.layerCount;
+                container.levels.push_back(level);
+                offset = level.offset + level.size;
+                if (width == 1u && height == 1u) {
+                    break;
+                }
+            }
+
+            container.data.resize(offset);
+            for (size_t i = 0u; i < container.data.size(); i++) {
+                container.data[i] = static_cast<uint8_t>(i * 31u + 7u);
+            }
+            return container;
+        }
+
+        static void TestAlignLevelOffset() {
+            FOX_CHECK(Fox::Core::TextureContainer::AlignLevelOffset(0u) == 0u);
+            FOX_CHECK(Fox::Core::TextureContainer::AlignLevelOffset(1u) == 16u);
+            FOX_CHECK(Fox::Core::TextureContainer::AlignLevelOffset(16u) == 16u);
+            FOX_CHECK(Fox::Core::TextureContainer::AlignLevelOffset(17u) == 32u);
+        }
+
+        static void TestRoundTrip() {
+            Fox::Core::TextureContainer written = MakeContainer();
+            std::string path = GetTemporaryPath("RoundTrip" + Fox::Core::TextureContainer::EXTENSION);
+            written.Write(path);
+
+            Fox::Core::TextureContainer mapped;
+            if (!FOX_CHECK(mapped.Map(path))) {
+                return;
+            }
+
+            FOX_CHECK(mapped.format == written.format);
+            FOX_CHECK(mapped.width == written.width && mapped.height == written.height);
+            FOX_CHECK(mapped.layerCount == written.layerCount);
+            FOX_CHECK(mapped.mipFilter == written.mipFilter);
+            FOX_CHECK(mapped.levels.size() == written.levels.size());
+            for (size_t i = 0u; i < std::min(mapped.levels.size(), written.levels.size()); i++) {
+                FOX_CHECK(mapped.levels[i].width == written.levels[i].width && mapped.levels[i].height == written.levels[i].height);
+                FOX_CHECK(mapped.levels[i].offset == written.levels[i].offset && mapped.levels[i].size == written.levels[i].size);
+            }
+
+            // the data is read from the mapping, not copied, and every level keeps its alignment there
+            FOX_CHECK(mapped.data.empty());
+            FOX_CHECK(mapped.GetDataSize() == written.GetDataSize());
+            FOX_CHECK(memcmp(mapped.GetData(), written.GetData(), static_cast<size_t>(written.GetDataSize())) == 0);
+            FOX_CHECK(reinterpret_cast<uintptr_t>(mapped.GetData()) % Fox::Core::TextureContainer::LEVEL_ALIGNMENT == 0u);
+        }
+
+        static void TestRejectsBadFiles() {
+            Fox::Core::TextureContainer container;
+            FOX_CHECK(!container.Map(GetTemporaryPath("Missing" + Fox::Core::TextureContainer::EXTENSION)));
+
+            Fox::Core::TextureContainer written = MakeContainer();
+            std::string path = GetTemporaryPath("Good" + Fox::Core::TextureContainer::EXTENSION);
+            written.Write(path);
+
+            std::vector<char> bytes;
+            {
+                std::ifstream file(path, std::ios::binary);
+                bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+
+            auto writeBytes = [](const std::string& path, const std::vector<char>& bytes) {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            };
+
+            // a file cut short in the data block must not map, the level table would point past its end
+            std::string truncatedPath = GetTemporaryPath("Truncated" + Fox::Core::TextureContainer::EXTENSION);
+            writeBytes(truncatedPath, std::vector<char>(bytes.begin(), bytes.end() - 1));
+            FOX_CHECK(!container.Map(truncatedPath));
+
+            std::vector<char> wrongMagic = bytes;
+            wrongMagic[0] ^= 0x1;
+            std::string magicPath = GetTemporaryPath("WrongMagic" + Fox::Core::TextureContainer::EXTENSION);
+            writeBytes(magicPath, wrongMagic);
+            FOX_CHECK(!container.Map(magicPath));
+
+            // containers of another version are re-cooked, never misread
+            std::vector<char> wrongVersion = bytes;
+            wrongVersion[4] ^= 0x1;
+            std::string versionPath = GetTemporaryPath("WrongVersion" + Fox::Core::TextureContainer::EXTENSION);
+            writeBytes(versionPath, wrongVersion);
+            FOX_CHECK(!container.Map(versionPath));
+
+            std::string emptyPath = GetTemporaryPath("Empty" + Fox::Core::TextureContainer::EXTENSION);
+            writeBytes(emptyPath, {});
+            FOX_CHECK(!container.Map(emptyPath));
+        }
+
+        static void TestIsUpToDate() {
+            std::string sourcePath = GetTemporaryPath("Source.png");
+            std::string containerPath = GetTemporaryPath("Source" + Fox::Core::TextureContainer::EXTENSION);
+            std::filesystem::remove(containerPath);
+            std::ofstream(sourcePath, std::ios::binary | std::ios::trunc) << "source";
+
+            FOX_CHECK(!Fox::Core::TextureContainer::IsUpToDate(containerPath, sourcePath));
+
+            MakeContainer().Write(containerPath);
+            auto now = std::filesystem::last_write_time(containerPath);
+
+            std::filesystem::last_write_time(sourcePath, now - std::chrono::hours(1));
+            FOX_CHECK(Fox::Core::TextureContainer::IsUpToDate(containerPath, sourcePath));
+
+            std::filesystem::last_write_time(sourcePath, now + std::chrono::hours(1));
+            FOX_CHECK(!Fox::Core::TextureContainer::IsUpToDate(containerPath, sourcePath));
+
+            // only the cache ships
+            std::filesystem::remove(sourcePath);
+            FOX_CHECK(Fox::Core::TextureContainer::IsUpToDate(containerPath, sourcePath));
+        }
+
+        void RunTextureContainerTests() {
+            TestAlignLevelOffset();
+            TestRoundTrip();
+            TestRejectsBadFiles();
+            TestIsUpToDate();
+        }
+	}
+}
@@ -0,0 +1,120 @@
+#include "pch.h"
+
+namespace Fox {
+
+	namespace Tests {
+
+        static void TestAlignment() {
+            Fox::Core::TlsfAllocator allocator(1u << 20u);
+
+            Fox::Core::TlsfAllocator::Allocation first;
+            FOX_CHECK(allocator.Allocate(3u, 1u, first));
+            FOX_CHECK(first.offset == 0u);
+
+            for (uint64_t alignment : { 4u, 16u, 256u, 4096u }) {
+                Fox::Core::TlsfAllocator::Allocation allocation;
+                FOX_CHECK(allocator.Allocate(100u, alignment, allocation));
+                FOX_CHECK(allocation.offset % alignment == 0u);
+                FOX_CHECK(allocation.size >= 100u);
+            }
+
+            // alignment 0 is taken as 1, size 0 is refused
+            Fox::Core::TlsfAllocator::Allocation unaligned;
+            FOX_CHECK(allocator.Allocate(7u, 0u, unaligned));
+            Fox::Core::TlsfAllocator::Allocation empty;
+            FOX_CHECK(!allocator.Allocate(0u, 1u, empty));
+            FOX_CHECK(!empty.IsValid());
+        }
+
+        static void TestExhaustion() {
+            Fox::Core::TlsfAllocator allocator(1024u);
+
+            Fox::Core::TlsfAllocator::Allocation all;
+            FOX_CHECK(allocator.Allocate(1024u, 1u, all));
+            FOX_CHECK(all.offset == 0u && all.size == 1024u);
+
+            Fox::Core::TlsfAllocator::Allocation more;
+            FOX_CHECK(!allocator.Allocate(1u, 1u, more));
+
+            allocator.Free(all);
+            FOX_CHECK(!all.IsValid());
+            FOX_CHECK(allocator.IsEmpty());
+            FOX_CHECK(allocator.Allocate(1024u, 1u, all));
+        }
+
+        static void TestCoalescing() {
+            Fox::Core::TlsfAllocator allocator(4096u);
+
+            std::vector<Fox::Core::TlsfAllocator::Allocation> allocations(4);
+            for (auto& allocation : allocations) {
+                FOX_CHECK(allocator.Allocate(1024u, 1u, allocation));
+            }
+
+            // freeing out of order leaves holes that have to merge back into one range
+            allocator.Free(allocations[1]);
+            allocator.Free(allocations[3]);
+            FOX_CHECK(allocator.GetStatistics().freeBlockCount == 2u);
+            allocator.Free(allocations[2]);
+            FOX_CHECK(allocator.GetStatistics().freeBlockCount == 1u);
+            allocator.Free(allocations[0]);
+
+            Fox::Core::AllocatorStatistics statistics = allocator.GetStatistics();
+            FOX_CHECK(statistics.usedBytes == 0u);
+            FOX_CHECK(statistics.freeBlockCount == 1u);
+            FOX_CHECK(statistics.largestFreeBlock == 4096u);
+            FOX_CHECK(statistics.GetFragmentation() == 0.0f);
+        }
+
+        static void TestRandom() {
+            const uint64_t capacity = 1u << 16u;
+            Fox::Core::TlsfAllocator allocator(capacity);
+            std::vector<Fox::Core::TlsfAllocator::Allocation> live;
+            std::mt19937 random(42u);
+
+            bool overlapFree = true;
+            bool accountingExact = true;
+            for (uint32_t step = 0u; step < 20000u; step++) {
+                if (!live.empty() && (random() % 3u == 0u || live.size() > 200u)) {
+                    size_t index = random() % live.size();
+                    allocator.Free(live[index]);
+                    live[index] = live.back();
+                    live.pop_back();
+                } else {
+                    uint64_t size = 1u + random() % 700u;
+                    uint64_t alignment = 1ull << (random() % 6u);
+                    Fox::Core::TlsfAllocator::Allocation allocation;
+                    if (allocator.Allocate(size, alignment, allocation)) {
+                        overlapFree = overlapFree && allocation.offset % alignment == 0u && allocation.offset + allocation.size <= capacity;
+                        live.push_back(allocation);
+                    }
+                }
+
+                uint64_t used = 0u;
+                for (const auto& allocation : live) {
+                    used += allocation.size;
+                }
+                accountingExact = accountingExact && used == allocator.GetUsedBytes();
+            }
+
+            std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) { return a.offset < b.offset; });
+            for (size_t i = 1u; i < live.size(); i++) {
+                overlapFree = overlapFree && live[i - 1u].offset + live[i - 1u].size <= live[i].offset;
+            }
+            FOX_CHECK(overlapFree);
+            FOX_CHECK(accountingExact);
+
+            for (auto& allocation : live) {
+                allocator.Free(allocation);
+            }
+            FOX_CHECK(allocator.IsEmpty());
+            FOX_CHECK(allocator.GetStatistics().largestFreeBlock == capacity);
+        }
+
+        void RunTlsfAllocatorTests() {
+            TestAlignment();
+            TestExhaustion();
+            TestCoalescing();
+            TestRandom();
+        }
+	}
+}
@@ -0,0 +1,15 @@
+#include "pch.h"
+
+// Checks of the CPU-only core modules, nothing here needs a GPU or a window. Exits with a failure when any check fails.
+int main() {
+    Fox::Tests::RunTlsfAllocatorTests();
+    Fox::Tests::RunBlockCompressionTests();
+    Fox::Tests::RunMipGeneratorTests();
+    Fox::Tests::RunTextureContainerTests();
+    Fox::Tests::RunSkylinePackerTests();
+    Fox::Tests::RunRadixSortTests();
+
+    const Fox::Tests::CheckResults& results = Fox::Tests::GetResults();
+    std::cout << results.passed << " checks passed, " << results.failed << " failed" << std::endl;
+    return results.failed == 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <fstream>
+#include <array>
+#include <chrono>
+#include <random>
+#include <functional>
+
+#include "core/TlsfAllocator.h"
+#include "core/ThreadPool.h"
+#include "core/BlockCompression.h"
+#include "core/MipGenerator.h"
+#include "core/MappedFile.h"
+#include "core/TextureContainer.h"
+#include "core/SkylinePacker.h"
+#include "core/RadixSort.h"
+
+#include "Check.h"